@@ -1,6 +1,7 @@
 #ifndef PANTHER_LIGHTS_APA102_HPP_
 #define PANTHER_LIGHTS_APA102_HPP_
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -8,16 +9,51 @@
 namespace panther_lights
 {
 
+enum class PixelFormat { RGB8, BGR8, RGBA8, BGRA8 };
+
+// pixels of a frame, formats without alpha channel use the same brightness for each pixel
+struct FrameView
+{
+  const std::uint8_t * data = nullptr;
+  std::size_t num_led = 0;
+  PixelFormat format = PixelFormat::RGBA8;
+  std::uint8_t brightness = 255;
+};
+
 class APA102
 {
 public:
   APA102(
     const std::string & device, const std::uint32_t speed = 800000, const bool cs_high = false);
-  ~APA102();
+  virtual ~APA102();
 
   void set_global_brightness(const std::uint8_t brightness);
   void set_global_brightness(const double brightness);
   void set_panel(const std::vector<std::uint8_t> & frame) const;
+  // writes frame using ordered temporal dithering, phase should be incremented with every refresh
+  void set_panel(const std::vector<std::uint8_t> & frame, const std::uint8_t dither_phase) const;
+
+  // encode frame into buffer ready to be written, buffer is resized only if its size differs
+  void encode(const std::vector<std::uint8_t> & frame, std::vector<std::uint8_t> & buffer) const;
+  void encode(
+    const std::vector<std::uint8_t> & frame, const std::uint8_t dither_phase,
+    std::vector<std::uint8_t> & buffer) const;
+  void encode(const FrameView & frame, std::vector<std::uint8_t> & buffer) const;
+  void encode(
+    const FrameView & frame, const std::uint8_t dither_phase,
+    std::vector<std::uint8_t> & buffer) const;
+  void write(const std::vector<std::uint8_t> & buffer) const { transfer(buffer); }
+
+protected:
+  // constructs panel that is not connected to any SPI device
+  APA102();
+
+  virtual void transfer(const std::vector<std::uint8_t> & buffer) const;
+
+  // color correction constants
+  const std::uint16_t corr_red_ = 255;
+  const std::uint16_t corr_green_ = 200;
+  const std::uint16_t corr_blue_ = 62;
 
 private:
   const int fd_;
@@ -25,11 +61,27 @@ private:
   const std::uint8_t bits_ = 8;
   const std::uint32_t speed_;
   std::uint16_t global_brightness_;
+  // global brightness in 8.8 fixed point, used by dithering to keep fraction of 5 bit value
+  std::uint16_t global_brightness_fine_;
 
-  // color correction constants
-  const std::uint16_t corr_red_ = 255;
-  const std::uint16_t corr_green_ = 200;
-  const std::uint16_t corr_blue_ = 62;
+  static FrameView rgba_frame_view(const std::vector<std::uint8_t> & frame);
+  static void init_buffer(const std::size_t num_led, std::vector<std::uint8_t> & buffer);
+
+  template <typename Layout>
+  void encode_pixels(const FrameView & frame, std::uint8_t * out) const;
+  template <typename Layout>
+  void encode_pixels(
+    const FrameView & frame, const std::uint8_t dither_phase, std::uint8_t * out) const;
+};
+
+// panel encoding frames as APA102 but discarding them instead of sending over SPI
+class NullAPA102 : public APA102
+{
+public:
+  NullAPA102() : APA102() {}
+
+protected:
+  void transfer(const std::vector<std::uint8_t> & /* buffer */) const override {}
 };
 
 }  // namespace panther_lights
@@ -0,0 +1,65 @@
+#ifndef PANTHER_LIGHTS_APA102_BUS_HPP_
+#define PANTHER_LIGHTS_APA102_BUS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <panther_lights/apa102.hpp>
+
+namespace panther_lights
+{
+
+// schedules writes of panels sharing one SPI controller. Frames are encoded into buffers allocated
+// once and panels with pending frames are written together in the order they were added, so the
+// bus is used by one refresh at a time and the front panel is always written before the rear one
+class APA102Bus
+{
+public:
+  APA102Bus() = default;
+
+  // returns index of the panel, panel has to outlive the bus
+  std::size_t add_panel(const APA102 & panel);
+
+  // encodes frame of the panel, it is written with the next flush. Pending frame of the panel is
+  // replaced
+  void set_panel(const std::size_t index, const FrameView & frame);
+  void set_panel(
+    const std::size_t index, const FrameView & frame, const std::uint8_t dither_phase);
+
+  // writes pending frames of all panels in fixed order
+  void flush();
+
+  // buffer with the last encoded frame of the panel
+  const std::vector<std::uint8_t> & get_buffer(const std::size_t index) const
+  {
+    return panels_.at(index).buffer;
+  }
+
+  bool is_pending(const std::size_t index) const { return panels_.at(index).pending; }
+  bool any_pending() const { return pending_count_ > 0; }
+  // true if each panel has a pending frame
+  bool all_pending() const { return pending_count_ == panels_.size(); }
+
+  // fraction of time the bus was busy since the last call
+  double take_utilization();
+
+private:
+  struct Panel
+  {
+    const APA102 * panel;
+    std::vector<std::uint8_t> buffer;
+    bool pending = false;
+  };
+
+  std::vector<Panel> panels_;
+  std::size_t pending_count_ = 0;
+  std::int64_t busy_ns_ = 0;
+  std::int64_t last_utilization_time_ = 0;
+
+  void mark_pending(Panel & panel);
+};
+
+}  // namespace panther_lights
+
+#endif  // PANTHER_LIGHTS_APA102_BUS_HPP_
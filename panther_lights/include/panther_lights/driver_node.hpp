@@ -1,6 +1,8 @@
 #ifndef PANTHER_LIGHTS_DRIVER_NODE_HPP_
 #define PANTHER_LIGHTS_DRIVER_NODE_HPP_
 
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <memory>
 #include <vector>
@@ -9,10 +11,19 @@
 #include <ros/ros.h>
 
 #include <image_transport/image_transport.h>
+#include <sensor_msgs/Image.h>
+#include <sensor_msgs/TimeReference.h>
+#include <std_msgs/Float64.h>
+#include <std_msgs/UInt8MultiArray.h>
 
 #include <panther_msgs/SetLEDBrightness.h>
 
+#include <panther_utils/async_logger.hpp>
+#include <panther_utils/histogram.hpp>
+
 #include <panther_lights/apa102.hpp>
+#include <panther_lights/apa102_bus.hpp>
+#include <panther_lights/led_state_encoder.hpp>
 
 namespace panther_lights
 {
@@ -26,27 +37,69 @@ public:
   ~DriverNode();
 
 private:
+  friend class TestDriverNodeAllocations;
+
+  struct PanelFrame
+  {
+    // keeps data of the view alive
+    sensor_msgs::Image::ConstPtr msg;
+    FrameView view;
+  };
+
   int num_led_;
   double frame_timeout_;
   bool panels_initialised_ = false;
+  bool dithering_;
+  bool report_write_time_;
+  double panel_write_deadline_;
+  // steady time in ns at which the oldest pending frame was set
+  std::int64_t first_pending_time_ = 0;
+  std::uint8_t dither_phase_ = 0;
   gpiod::line power_pin_;
   std::string node_name_;
 
-  APA102 front_panel_;
-  APA102 rear_panel_;
+  std::unique_ptr<APA102> front_panel_;
+  std::unique_ptr<APA102> rear_panel_;
+  APA102Bus panel_bus_;
+  std::size_t front_panel_id_;
+  std::size_t rear_panel_id_;
+  // stamps of frames waiting to be written, zero if panel has no pending frame
+  std::vector<ros::Time> pending_frame_stamps_;
+  std::vector<const char *> panel_names_;
+  double state_stream_keyframe_period_;
+  ros::WallTime last_state_keyframe_time_;
+  LEDStateEncoder state_encoder_;
+  std_msgs::UInt8MultiArray state_msg_;
 
   ros::Time front_panel_ts_;
   ros::Time rear_panel_ts_;
+  PanelFrame front_frame_;
+  PanelFrame rear_frame_;
   std::shared_ptr<ros::NodeHandle> ph_;
   std::shared_ptr<ros::NodeHandle> nh_;
   std::shared_ptr<image_transport::ImageTransport> it_;
+  ros::Publisher markers_pub_;
+  ros::Publisher write_time_pub_;
+  ros::Publisher bus_utilization_pub_;
+  ros::Publisher state_pub_;
   ros::ServiceServer set_brightness_server_;
   image_transport::Subscriber rear_light_sub_;
   image_transport::Subscriber front_light_sub_;
+  ros::SteadyTimer dithering_timer_;
+  ros::SteadyTimer pending_write_timer_;
+  ros::SteadyTimer bus_stats_timer_;
+  ros::SteadyTimer state_stream_timer_;
+  panther_utils::Histogram write_time_hist_;
+  panther_utils::AsyncLogger & logger_ = panther_utils::AsyncLogger::instance();
 
   void frame_cb(
-    const sensor_msgs::Image::ConstPtr & msg, const APA102 & panel, const ros::Time & last_time,
-    const std::string & panel_name);
+    const sensor_msgs::Image::ConstPtr & msg, const std::size_t panel_id, PanelFrame & frame,
+    const ros::Time & last_time, const char * panel_name);
+  void write_panels();
+  void pending_write_timer_cb();
+  void dithering_timer_cb();
+  void bus_stats_timer_cb();
+  void state_stream_timer_cb();
   bool set_brightness_cb(
     panther_msgs::SetLEDBrightness::Request & req, panther_msgs::SetLEDBrightness::Response & res);
 };
@@ -0,0 +1,41 @@
+#ifndef PANTHER_LIGHTS_LED_STATE_DECODER_HPP_
+#define PANTHER_LIGHTS_LED_STATE_DECODER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace panther_lights
+{
+
+// restores LED values from frames produced by LEDStateEncoder. Delta frame is applied only if it
+// directly follows the previously decoded frame, after a lost or malformed frame the decoder waits
+// for the next keyframe
+class LEDStateDecoder
+{
+public:
+  LEDStateDecoder() = default;
+
+  // returns true if state was updated with the frame
+  bool decode(const std::vector<std::uint8_t> & frame);
+
+  // true once a keyframe was decoded and no frame was lost since then
+  bool synchronized() const { return synchronized_; }
+
+  // LED values of each panel, 4 bytes per LED: [brightness] [blue] [green] [red]
+  const std::vector<std::vector<std::uint8_t>> & panels() const { return panels_; }
+
+private:
+  bool synchronized_ = false;
+  std::uint16_t last_sequence_ = 0;
+  std::vector<std::vector<std::uint8_t>> panels_;
+  std::vector<std::vector<std::uint8_t>> decoded_;
+
+  static bool decode_panel(
+    const std::vector<std::uint8_t> & frame, std::size_t & pos,
+    const std::vector<std::uint8_t> * previous, std::vector<std::uint8_t> & panel);
+};
+
+}  // namespace panther_lights
+
+#endif  // PANTHER_LIGHTS_LED_STATE_DECODER_HPP_
@@ -0,0 +1,46 @@
+#ifndef PANTHER_LIGHTS_LED_STATE_ENCODER_HPP_
+#define PANTHER_LIGHTS_LED_STATE_ENCODER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace panther_lights
+{
+
+// compresses LED values written to panels. Each panel is encoded as a sequence of runs, a run of
+// LEDs with the same value is stored once and in delta frames a run of LEDs that didn't change
+// since the previous frame is stored as a single byte. Sequence number is incremented with each
+// frame, so a receiver can detect lost frames and wait for the next keyframe. Multi-byte values
+// are little-endian
+//
+// frame:  [version] [flags] [sequence (2 B)] [number of panels]
+//         then for each panel [number of LEDs (2 B)] [runs]
+// run:    [0nnnnnnn] [brightness] [blue] [green] [red] - n + 1 LEDs with the given value
+//         [1nnnnnnn]                                  - n + 1 LEDs unchanged, only in delta frames
+class LEDStateEncoder
+{
+public:
+  static constexpr std::uint8_t version = 2;
+  static constexpr std::uint8_t keyframe_flag = 0x01;
+
+  // panel buffers are APA102 buffers with start and end frames. Delta frame is encoded only if
+  // number of panels and LEDs didn't change since the previous frame, otherwise keyframe is used
+  void encode(
+    const std::vector<const std::vector<std::uint8_t> *> & panel_buffers, bool keyframe,
+    std::vector<std::uint8_t> & out);
+
+private:
+  static constexpr std::size_t max_run_length_ = 128;
+
+  std::uint16_t sequence_ = 0;
+  std::vector<std::vector<std::uint8_t>> previous_;
+
+  static void encode_panel(
+    const std::vector<std::uint8_t> & buffer, const std::vector<std::uint8_t> * previous,
+    std::vector<std::uint8_t> & out);
+};
+
+}  // namespace panther_lights
+
+#endif  // PANTHER_LIGHTS_LED_STATE_ENCODER_HPP_
@@ -0,0 +1,36 @@
+#ifndef PANTHER_LIGHTS_SIM_APA102_HPP_
+#define PANTHER_LIGHTS_SIM_APA102_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <ros/ros.h>
+
+#include <visualization_msgs/Marker.h>
+
+#include <panther_lights/apa102.hpp>
+
+namespace panther_lights
+{
+
+// panel displaying frames in simulation, each written frame is published as a single marker
+class SimAPA102 : public APA102
+{
+public:
+  SimAPA102(
+    const ros::Publisher & marker_pub, const std::string & frame_id, const std::string & ns,
+    const int num_led, const double led_spacing = 0.0125);
+
+protected:
+  void transfer(const std::vector<std::uint8_t> & buffer) const override;
+
+private:
+  ros::Publisher marker_pub_;
+  mutable visualization_msgs::Marker marker_;
+  mutable std::vector<std::uint8_t> last_buffer_;
+};
+
+}  // namespace panther_lights
+
+#endif  // PANTHER_LIGHTS_SIM_APA102_HPP_
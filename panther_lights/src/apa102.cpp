@@ -5,15 +5,60 @@
 #include <sys/ioctl.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <fstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include <panther_utils/tracepoints.hpp>
+
 namespace panther_lights
 {
+
+namespace
+{
+// reversing bits of a counter gives a sequence of thresholds that is spread evenly over time
+inline std::uint8_t dither_threshold(const std::uint8_t phase)
+{
+  std::uint8_t t = phase;
+  t = std::uint8_t((t & 0xF0) >> 4 | (t & 0x0F) << 4);
+  t = std::uint8_t((t & 0xCC) >> 2 | (t & 0x33) << 2);
+  t = std::uint8_t((t & 0xAA) >> 1 | (t & 0x55) << 1);
+  return t;
+}
+
+// adds threshold to 8.8 fixed point value and returns integer part clamped to max_value
+inline std::uint8_t dither(
+  const std::uint32_t value_fine, const std::uint8_t threshold, const std::uint8_t max_value)
+{
+  const std::uint32_t value = (value_fine + threshold) >> 8;
+  return value > max_value ? max_value : std::uint8_t(value);
+}
+
+// byte offsets of color channels in a pixel
+template <
+  std::size_t Stride, std::size_t R, std::size_t G, std::size_t B, bool HasAlpha,
+  std::size_t A = 0>
+struct PixelLayout
+{
+  static constexpr std::size_t stride = Stride;
+  static constexpr std::size_t r = R;
+  static constexpr std::size_t g = G;
+  static constexpr std::size_t b = B;
+  static constexpr std::size_t a = A;
+  static constexpr bool has_alpha = HasAlpha;
+};
+
+using RGB8Layout = PixelLayout<3, 0, 1, 2, false>;
+using BGR8Layout = PixelLayout<3, 2, 1, 0, false>;
+using RGBA8Layout = PixelLayout<4, 0, 1, 2, true, 3>;
+using BGRA8Layout = PixelLayout<4, 2, 1, 0, true, 3>;
+}  // namespace
+
 APA102::APA102(const std::string & device, const std::uint32_t speed, const bool cs_high)
 : device_(device), speed_(speed), fd_(open(device.c_str(), O_WRONLY))
 {
@@ -38,59 +83,190 @@ APA102::APA102(const std::string & device, const std::uint32_t speed, const bool
   }
 }
 
-APA102::~APA102() { close(fd_); }
+APA102::APA102() : fd_(-1), device_(""), speed_(0) {}
+
+APA102::~APA102()
+{
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
 
 void APA102::set_global_brightness(const double brightness)
 {
   std::uint8_t val = brightness > 0.0f ? ceil(brightness * 31.0f) : 0;
   set_global_brightness(val);
+  global_brightness_fine_ = std::uint16_t(round(std::clamp(brightness, 0.0, 1.0) * 31.0 * 256.0));
 }
 
 void APA102::set_global_brightness(const std::uint8_t brightness)
 {
   // clamp values to be at max 31
   global_brightness_ = std::uint16_t(brightness) & 0x1F;
+  global_brightness_fine_ = global_brightness_ << 8;
 }
 
 void APA102::set_panel(const std::vector<std::uint8_t> & frame) const
+{
+  std::vector<std::uint8_t> buffer;
+  encode(frame, buffer);
+  transfer(buffer);
+}
+
+void APA102::set_panel(
+  const std::vector<std::uint8_t> & frame, const std::uint8_t dither_phase) const
+{
+  std::vector<std::uint8_t> buffer;
+  encode(frame, dither_phase, buffer);
+  transfer(buffer);
+}
+
+void APA102::encode(
+  const std::vector<std::uint8_t> & frame, std::vector<std::uint8_t> & buffer) const
+{
+  encode(rgba_frame_view(frame), buffer);
+}
+
+void APA102::encode(
+  const std::vector<std::uint8_t> & frame, const std::uint8_t dither_phase,
+  std::vector<std::uint8_t> & buffer) const
+{
+  encode(rgba_frame_view(frame), dither_phase, buffer);
+}
+
+void APA102::encode(const FrameView & frame, std::vector<std::uint8_t> & buffer) const
+{
+  PANTHER_TRACEPOINT(apa102_encode_begin, frame.num_led);
+  init_buffer(frame.num_led, buffer);
+  auto out = buffer.data() + 4;
+  switch (frame.format) {
+    case PixelFormat::RGB8:
+      encode_pixels<RGB8Layout>(frame, out);
+      break;
+    case PixelFormat::BGR8:
+      encode_pixels<BGR8Layout>(frame, out);
+      break;
+    case PixelFormat::RGBA8:
+      encode_pixels<RGBA8Layout>(frame, out);
+      break;
+    case PixelFormat::BGRA8:
+      encode_pixels<BGRA8Layout>(frame, out);
+      break;
+  }
+  PANTHER_TRACEPOINT(apa102_encode_end, frame.num_led);
+}
+
+void APA102::encode(
+  const FrameView & frame, const std::uint8_t dither_phase,
+  std::vector<std::uint8_t> & buffer) const
+{
+  PANTHER_TRACEPOINT(apa102_encode_begin, frame.num_led);
+  init_buffer(frame.num_led, buffer);
+  auto out = buffer.data() + 4;
+  switch (frame.format) {
+    case PixelFormat::RGB8:
+      encode_pixels<RGB8Layout>(frame, dither_phase, out);
+      break;
+    case PixelFormat::BGR8:
+      encode_pixels<BGR8Layout>(frame, dither_phase, out);
+      break;
+    case PixelFormat::RGBA8:
+      encode_pixels<RGBA8Layout>(frame, dither_phase, out);
+      break;
+    case PixelFormat::BGRA8:
+      encode_pixels<BGRA8Layout>(frame, dither_phase, out);
+      break;
+  }
+  PANTHER_TRACEPOINT(apa102_encode_end, frame.num_led);
+}
+
+FrameView APA102::rgba_frame_view(const std::vector<std::uint8_t> & frame)
 {
   if (frame.size() % 4 != 0) {
     throw std::runtime_error("Incorrect number of bytes to transfer to LEDs");
   }
+  FrameView view;
+  view.data = frame.data();
+  view.num_led = frame.size() / 4;
+  view.format = PixelFormat::RGBA8;
+  return view;
+}
+
+void APA102::init_buffer(const std::size_t num_led, std::vector<std::uint8_t> & buffer)
+{
   // init buffer with start and end frames
-  std::size_t buffer_size = (4 * sizeof(std::uint8_t)) + frame.size() + (4 * sizeof(std::uint8_t));
-  std::uint8_t * buffer = new std::uint8_t[buffer_size];
+  std::size_t buffer_size = (4 * sizeof(std::uint8_t)) + num_led * 4 + (4 * sizeof(std::uint8_t));
+  buffer.resize(buffer_size);
 
   // init start and end frames
   for (std::size_t i = 0; i < 4; i++) {
     buffer[i] = 0x00;
     buffer[buffer_size - i - 1] = 0xFF;
   }
+}
+
+// layout is known at compile time, so loops have constant strides and offsets and can be vectorized
+template <typename Layout>
+void APA102::encode_pixels(const FrameView & frame, std::uint8_t * out) const
+{
+  const std::uint8_t * in = frame.data;
+  // header with brightness is the same for each LED if frame has no alpha channel
+  const std::uint8_t frame_header =
+    0xE0 | std::uint8_t((std::uint16_t(frame.brightness) * global_brightness_) / 255);
+
+  for (std::size_t i = 0; i < frame.num_led; i++) {
+    const std::uint8_t * pixel = in + i * Layout::stride;
+    std::uint8_t * led = out + i * 4;
+    if constexpr (Layout::has_alpha) {
+      led[0] = 0xE0 | std::uint8_t((std::uint16_t(pixel[Layout::a]) * global_brightness_) / 255);
+    } else {
+      led[0] = frame_header;
+    }
+    // convert to bgr with collor correction
+    led[1] = std::uint8_t((std::uint16_t(pixel[Layout::b]) * corr_blue_) / 255);
+    led[2] = std::uint8_t((std::uint16_t(pixel[Layout::g]) * corr_green_) / 255);
+    led[3] = std::uint8_t((std::uint16_t(pixel[Layout::r]) * corr_red_) / 255);
+  }
+}
+
+template <typename Layout>
+void APA102::encode_pixels(
+  const FrameView & frame, const std::uint8_t dither_phase, std::uint8_t * out) const
+{
+  const std::uint8_t * in = frame.data;
 
-  // copy frame from vector to sending buffer
-  for (std::size_t i = 0; i < frame.size() / 4; i++) {
-    // padding
-    std::size_t pad = i * 4;
-    // header with brightness
-    std::uint8_t brightness = (std::uint16_t(frame[pad + 3]) * global_brightness_) / 255;
-    buffer[4 + pad] = 0xE0 | brightness;
-    // convert rgb to bgr with collor correction
-    buffer[4 + pad + 1] = std::uint8_t((std::uint16_t(frame[pad + 2]) * corr_blue_) / 255);
-    buffer[4 + pad + 2] = std::uint8_t((std::uint16_t(frame[pad + 1]) * corr_green_) / 255);
-    buffer[4 + pad + 3] = std::uint8_t((std::uint16_t(frame[pad + 0]) * corr_red_) / 255);
+  for (std::size_t i = 0; i < frame.num_led; i++) {
+    const std::uint8_t * pixel = in + i * Layout::stride;
+    std::uint8_t * led = out + i * 4;
+    // offset threshold for each LED so they don't change their values at the same refresh
+    const std::uint8_t threshold = dither_threshold(std::uint8_t(dither_phase + i * 37));
+    // keep 8 fractional bits of scaled values and let dithering distribute them over time
+    std::uint32_t alpha = frame.brightness;
+    if constexpr (Layout::has_alpha) {
+      alpha = pixel[Layout::a];
+    }
+    const std::uint32_t brightness = (alpha * global_brightness_fine_) / 255;
+    led[0] = 0xE0 | dither(brightness, threshold, 0x1F);
+    led[1] = dither((std::uint32_t(pixel[Layout::b]) * corr_blue_ * 256) / 255, threshold, 0xFF);
+    led[2] = dither((std::uint32_t(pixel[Layout::g]) * corr_green_ * 256) / 255, threshold, 0xFF);
+    led[3] = dither((std::uint32_t(pixel[Layout::r]) * corr_red_ * 256) / 255, threshold, 0xFF);
   }
+}
 
+void APA102::transfer(const std::vector<std::uint8_t> & buffer) const
+{
   struct spi_ioc_transfer tr = {
-    .tx_buf = (unsigned long long)buffer,
+    .tx_buf = (unsigned long long)buffer.data(),
     .rx_buf = 0,
-    .len = (unsigned int)buffer_size,
+    .len = (unsigned int)buffer.size(),
     .speed_hz = speed_,
     .delay_usecs = 0,
     .bits_per_word = 8,
   };
 
+  PANTHER_TRACEPOINT(apa102_ioctl_begin, device_.c_str(), buffer.size());
   int ret = ioctl(fd_, SPI_IOC_MESSAGE(1), &tr);
-  delete[] buffer;
+  PANTHER_TRACEPOINT(apa102_ioctl_end, device_.c_str(), ret);
 
   if (ret < 1) {
     throw std::ios_base::failure(std::string("Failed to send data over SPI ") + device_);
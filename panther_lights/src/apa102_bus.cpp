@@ -0,0 +1,74 @@
+#include <panther_lights/apa102_bus.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <panther_utils/steady_clock.hpp>
+
+#include <panther_lights/apa102.hpp>
+
+namespace panther_lights
+{
+
+std::size_t APA102Bus::add_panel(const APA102 & panel)
+{
+  Panel bus_panel;
+  bus_panel.panel = &panel;
+  panels_.push_back(std::move(bus_panel));
+  return panels_.size() - 1;
+}
+
+void APA102Bus::set_panel(const std::size_t index, const FrameView & frame)
+{
+  auto & panel = panels_.at(index);
+  panel.panel->encode(frame, panel.buffer);
+  mark_pending(panel);
+}
+
+void APA102Bus::set_panel(
+  const std::size_t index, const FrameView & frame, const std::uint8_t dither_phase)
+{
+  auto & panel = panels_.at(index);
+  panel.panel->encode(frame, dither_phase, panel.buffer);
+  mark_pending(panel);
+}
+
+void APA102Bus::flush()
+{
+  if (!pending_count_) {
+    return;
+  }
+
+  const panther_utils::Stopwatch stopwatch;
+  for (auto & panel : panels_) {
+    if (panel.pending) {
+      panel.panel->write(panel.buffer);
+      panel.pending = false;
+    }
+  }
+  pending_count_ = 0;
+  busy_ns_ += stopwatch.elapsed_ns();
+}
+
+double APA102Bus::take_utilization()
+{
+  const auto now = panther_utils::steady_now_ns();
+  const auto elapsed = now - last_utilization_time_;
+  const double utilization =
+    last_utilization_time_ && elapsed > 0 ? double(busy_ns_) / double(elapsed) : 0.0;
+  last_utilization_time_ = now;
+  busy_ns_ = 0;
+  return utilization;
+}
+
+void APA102Bus::mark_pending(Panel & panel)
+{
+  if (!panel.pending) {
+    panel.pending = true;
+    pending_count_++;
+  }
+}
+
+}  // namespace panther_lights
@@ -291,13 +291,14 @@ class LightsControllerNode:
         img_msg = Image()
         img_msg.header.frame_id = frame_id
         img_msg.header.stamp = rospy.Time.now()
-        img_msg.encoding = 'rgba8'
+        # packed frame, brightness of all LEDs is carried in the encoding
+        img_msg.encoding = f'rgb8; brightness={int(brightness)}'
         img_msg.height = 1
         img_msg.width = self._num_led
-        img_msg.step = 4 * self._num_led
+        img_msg.step = 3 * self._num_led
 
-        rgba_array = [val for rgba in [rgb + [brightness] for rgb in rgb_frame] for val in rgba]
-        img_msg.data = bytes(rgba_array)
+        rgb_array = [val for rgb in rgb_frame for val in rgb]
+        img_msg.data = bytes(rgb_array)
 
         return img_msg
 
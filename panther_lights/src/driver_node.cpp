@@ -1,48 +1,165 @@
 #include <panther_lights/driver_node.hpp>
 
+#include <charconv>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
 #include <gpiod.hpp>
 #include <ros/ros.h>
 
 #include <image_transport/image_transport.h>
+#include <sensor_msgs/TimeReference.h>
 #include <sensor_msgs/image_encodings.h>
+#include <std_msgs/Float64.h>
+#include <std_msgs/UInt8MultiArray.h>
+#include <visualization_msgs/Marker.h>
 
 #include <panther_msgs/SetLEDBrightness.h>
 
+#include <panther_utils/async_logger.hpp>
+#include <panther_utils/histogram.hpp>
+#include <panther_utils/steady_clock.hpp>
+#include <panther_utils/tracepoints.hpp>
+
 #include <panther_lights/apa102.hpp>
+#include <panther_lights/apa102_bus.hpp>
+#include <panther_lights/led_state_encoder.hpp>
+#include <panther_lights/sim_apa102.hpp>
 
 namespace panther_lights
 {
 
+namespace
+{
+// parses " brightness=<0-255>" suffix of packed frame encoding
+bool parse_brightness(std::string_view str, std::uint8_t & brightness)
+{
+  constexpr std::string_view key = "brightness=";
+  while (!str.empty() && str.front() == ' ') {
+    str.remove_prefix(1);
+  }
+  if (str.substr(0, key.size()) != key) {
+    return false;
+  }
+  str.remove_prefix(key.size());
+
+  unsigned value;
+  const auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+  if (ec != std::errc() || end != str.data() + str.size() || value > 255) {
+    return false;
+  }
+  brightness = std::uint8_t(value);
+  return true;
+}
+
+// returns false if encoding is not supported or size of data doesn't match it
+bool get_frame_view(const sensor_msgs::Image & msg, FrameView & view)
+{
+  namespace encodings = sensor_msgs::image_encodings;
+
+  view.data = msg.data.data();
+  view.num_led = msg.width;
+  view.brightness = 255;
+
+  // packed frame carries brightness of all LEDs in the encoding, e.g. "rgb8; brightness=128"
+  std::string_view encoding = msg.encoding;
+  const auto separator = encoding.find(';');
+  if (separator != std::string_view::npos) {
+    if (!parse_brightness(encoding.substr(separator + 1), view.brightness)) {
+      return false;
+    }
+    encoding = encoding.substr(0, separator);
+  }
+
+  if (encoding == encodings::RGBA8 || encoding == encodings::BGRA8) {
+    view.format = encoding == encodings::RGBA8 ? PixelFormat::RGBA8 : PixelFormat::BGRA8;
+    // brightness is already given by the alpha channel
+    return separator == std::string_view::npos && msg.data.size() == 4 * view.num_led;
+  }
+
+  if (encoding == encodings::RGB8 || encoding == encodings::BGR8) {
+    view.format = encoding == encodings::RGB8 ? PixelFormat::RGB8 : PixelFormat::BGR8;
+    return msg.data.size() == 3 * view.num_led;
+  }
+
+  return false;
+}
+}  // namespace
+
 DriverNode::DriverNode(
   const std::shared_ptr<ros::NodeHandle> & ph, std::shared_ptr<ros::NodeHandle> & nh,
   const std::shared_ptr<image_transport::ImageTransport> & it)
 : ph_(std::move(ph)),
   nh_(std::move(nh)),
-  it_(std::move(it)),
-  front_panel_("/dev/spidev0.0"),
-  rear_panel_("/dev/spidev0.1")
+  it_(std::move(it))
 {
   node_name_ = ros::this_node::getName();
 
   const double global_brightness = ph_->param<double>("global_brightness", 1.0);
   frame_timeout_ = ph_->param<double>("frame_timeout", 0.1);
   num_led_ = ph_->param<int>("num_led", 46);
+  dithering_ = ph_->param<bool>("dithering", false);
+  const double dithering_frequency = ph_->param<double>("dithering_frequency", 150.0);
+  const auto panel_backend = ph_->param<std::string>("panel_backend", "spi");
+  report_write_time_ = ph_->param<bool>("report_write_time", false);
+  panel_write_deadline_ = ph_->param<double>("panel_write_deadline", 0.005);
+  const double bus_stats_period = ph_->param<double>("bus_stats_period", 1.0);
+  const double state_stream_rate = ph_->param<double>("state_stream_rate", 1.0);
+  state_stream_keyframe_period_ = ph_->param<double>("state_stream_keyframe_period", 10.0);
+
+  if (panel_backend == "spi") {
+    front_panel_ = std::make_unique<APA102>("/dev/spidev0.0");
+    rear_panel_ = std::make_unique<APA102>("/dev/spidev0.1");
 
-  const gpiod::chip chip("gpiochip0");
-  power_pin_ = chip.find_line("LED_SBC_SEL");
+    const gpiod::chip chip("gpiochip0");
+    power_pin_ = chip.find_line("LED_SBC_SEL");
+
+    const gpiod::line_request lr = {
+      node_name_, gpiod::line_request::DIRECTION_OUTPUT, gpiod::line_request::FLAG_ACTIVE_LOW};
+    power_pin_.request(lr, 0);
+  } else if (panel_backend == "sim") {
+    markers_pub_ = nh_->advertise<visualization_msgs::Marker>("lights/driver/markers", 2);
+    front_panel_ =
+      std::make_unique<SimAPA102>(markers_pub_, "front_light_link", "front_panel", num_led_);
+    rear_panel_ =
+      std::make_unique<SimAPA102>(markers_pub_, "rear_light_link", "rear_panel", num_led_);
+  } else if (panel_backend == "null") {
+    front_panel_ = std::make_unique<NullAPA102>();
+    rear_panel_ = std::make_unique<NullAPA102>();
+  } else {
+    throw std::invalid_argument("Invalid panel backend: " + panel_backend);
+  }
 
-  const gpiod::line_request lr = {
-    node_name_, gpiod::line_request::DIRECTION_OUTPUT, gpiod::line_request::FLAG_ACTIVE_LOW};
-  power_pin_.request(lr, 0);
+  // both panels share one SPI controller, so they are written by a single bus in a fixed order
+  front_panel_id_ = panel_bus_.add_panel(*front_panel_);
+  rear_panel_id_ = panel_bus_.add_panel(*rear_panel_);
+  pending_frame_stamps_.resize(2);
+  panel_names_ = {"front", "rear"};
 
   front_panel_ts_ = ros::Time::now();
   rear_panel_ts_ = ros::Time::now();
 
-  front_panel_.set_global_brightness(global_brightness);
-  rear_panel_.set_global_brightness(global_brightness);
+  front_panel_->set_global_brightness(global_brightness);
+  rear_panel_->set_global_brightness(global_brightness);
+
+  // -------------------------------
+  //   Publishers
+  // -------------------------------
+
+  if (report_write_time_) {
+    write_time_pub_ = nh_->advertise<sensor_msgs::TimeReference>("lights/driver/write_time", 10);
+  }
+  if (bus_stats_period > 0.0) {
+    bus_utilization_pub_ = nh_->advertise<std_msgs::Float64>("lights/driver/bus_utilization", 1);
+  }
+  if (state_stream_rate > 0.0) {
+    state_pub_ = nh_->advertise<std_msgs::UInt8MultiArray>("lights/driver/state", 1);
+  }
 
   // -------------------------------
   //   Subscribers
@@ -50,13 +167,13 @@ DriverNode::DriverNode(
 
   front_light_sub_ = it_->subscribe(
     "lights/driver/front_panel_frame", 5, [&](const sensor_msgs::Image::ConstPtr & msg) {
-      frame_cb(msg, front_panel_, front_panel_ts_, "front");
+      frame_cb(msg, front_panel_id_, front_frame_, front_panel_ts_, "front");
       front_panel_ts_ = msg->header.stamp;
     });
 
   rear_light_sub_ = it_->subscribe(
     "lights/driver/rear_panel_frame", 5, [this](const sensor_msgs::Image::ConstPtr & msg) {
-      frame_cb(msg, rear_panel_, rear_panel_ts_, "rear");
+      frame_cb(msg, rear_panel_id_, rear_frame_, rear_panel_ts_, "rear");
       rear_panel_ts_ = msg->header.stamp;
     });
 
@@ -67,6 +184,36 @@ DriverNode::DriverNode(
   set_brightness_server_ =
     nh_->advertiseService("lights/driver/set/brightness", &DriverNode::set_brightness_cb, this);
 
+  // -------------------------------
+  //   Timers
+  // -------------------------------
+
+  if (dithering_) {
+    // refresh panels faster than frames arrive to display fractions of LED values
+    dithering_timer_ = nh_->createSteadyTimer(
+      ros::WallDuration(1.0 / dithering_frequency),
+      std::bind(&DriverNode::dithering_timer_cb, this));
+  }
+
+  if (!dithering_ && panel_write_deadline_ > 0.0) {
+    // one-shot timer created once and re-armed by frame_cb, as creating a timer for each refresh
+    // allocates
+    pending_write_timer_ = nh_->createSteadyTimer(
+      ros::WallDuration(panel_write_deadline_),
+      std::bind(&DriverNode::pending_write_timer_cb, this), true);
+  }
+
+  if (bus_stats_period > 0.0) {
+    bus_stats_timer_ = nh_->createSteadyTimer(
+      ros::WallDuration(bus_stats_period), std::bind(&DriverNode::bus_stats_timer_cb, this));
+  }
+
+  if (state_stream_rate > 0.0) {
+    state_stream_timer_ = nh_->createSteadyTimer(
+      ros::WallDuration(1.0 / state_stream_rate),
+      std::bind(&DriverNode::state_stream_timer_cb, this));
+  }
+
   while (ros::ok() && !panels_initialised_) {
     ROS_INFO_THROTTLE(5.0, "[%s] Waiting for animation to arrive...", node_name_.c_str());
     ros::Duration(1.0 / 30.0).sleep();
@@ -79,13 +226,20 @@ DriverNode::DriverNode(
 
 DriverNode::~DriverNode()
 {
+  ROS_INFO(
+    "[%s] Panels write time [ms] p50: %.3f, p99: %.3f, max: %.3f (%lu writes)", node_name_.c_str(),
+    write_time_hist_.percentile(50.0) * 1e-6, write_time_hist_.percentile(99.0) * 1e-6,
+    write_time_hist_.max() * 1e-6, write_time_hist_.count());
+
   // clear LEDs
-  front_panel_.set_panel(std::vector<std::uint8_t>(num_led_ * 4, 0));
-  rear_panel_.set_panel(std::vector<std::uint8_t>(num_led_ * 4, 0));
+  front_panel_->set_panel(std::vector<std::uint8_t>(num_led_ * 4, 0));
+  rear_panel_->set_panel(std::vector<std::uint8_t>(num_led_ * 4, 0));
 
   // give back control over LEDs
-  power_pin_.set_value(0);
-  power_pin_.release();
+  if (power_pin_) {
+    power_pin_.set_value(0);
+    power_pin_.release();
+  }
 }
 
 bool DriverNode::set_brightness_cb(
@@ -97,8 +251,8 @@ bool DriverNode::set_brightness_cb(
     res.message = "Brightness out of range <0,1>";
     return true;
   }
-  front_panel_.set_global_brightness(brightness);
-  rear_panel_.set_global_brightness(brightness);
+  front_panel_->set_global_brightness(brightness);
+  rear_panel_->set_global_brightness(brightness);
   auto str_bright = std::to_string(brightness);
 
   // round string to two decimal places
@@ -109,39 +263,133 @@ bool DriverNode::set_brightness_cb(
 }
 
 void DriverNode::frame_cb(
-  const sensor_msgs::Image::ConstPtr & msg, const APA102 & panel, const ros::Time & last_time,
-  const std::string & panel_name)
+  const sensor_msgs::Image::ConstPtr & msg, const std::size_t panel_id, PanelFrame & frame,
+  const ros::Time & last_time, const char * panel_name)
 {
-  std::string meessage;
-  if ((ros::Time::now() - msg->header.stamp).toSec() > frame_timeout_) {
-    meessage = "Timeout exceeded, ignoring frame";
+  PANTHER_TRACEPOINT(frame_cb_entry, panel_name, msg->header.stamp.toNSec());
+  FrameView frame_view;
+
+  // log messages are throttled separately for each panel
+  const auto frame_age = (ros::Time::now() - msg->header.stamp).toSec();
+  if (frame_age > frame_timeout_) {
+    logger_.warn_throttle(5.0, "Timeout exceeded, ignoring frame on %s panel!", panel_name);
   } else if (msg->header.stamp < last_time) {
-    meessage = "Dropping message from past";
-  } else if (msg->encoding != sensor_msgs::image_encodings::RGBA8) {
-    meessage = "Incorrect image encoding ('" + msg->encoding + "')";
+    logger_.warn_throttle(5.0, "Dropping message from past on %s panel!", panel_name);
   } else if (msg->height != 1) {
-    meessage = "Incorrect image height " + std::to_string(msg->height);
+    logger_.warn_throttle(5.0, "Incorrect image height %u on %s panel!", msg->height, panel_name);
   } else if (msg->width != num_led_) {
-    meessage = "Incorrect image width " + std::to_string(msg->width);
-  } else if ((ros::Time::now() - msg->header.stamp).toSec() > 5.0) {
-    meessage = "Timeout. Dropping frame";
-  }
-
-  if (!meessage.empty()) {
-    if (panel_name == "front") {
-      ROS_WARN_THROTTLE(5.0, "[%s] %s on front panel!", node_name_.c_str(), meessage.c_str());
-    } else if (panel_name == "rear") {
-      ROS_WARN_THROTTLE(5.0, "[%s] %s on front rear!", node_name_.c_str(), meessage.c_str());
-    }
+    logger_.warn_throttle(5.0, "Incorrect image width %u on %s panel!", msg->width, panel_name);
+  } else if (!get_frame_view(*msg, frame_view)) {
+    logger_.warn_throttle(
+      5.0, "Incorrect image encoding ('%s') or data size (%lu) on %s panel!", msg->encoding,
+      msg->data.size(), panel_name);
+  } else if (frame_age > 5.0) {
+    logger_.warn_throttle(5.0, "Timeout. Dropping frame on %s panel!", panel_name);
   } else {
     if (!panels_initialised_) {
       panels_initialised_ = true;
 
       // take control over LEDs
-      power_pin_.set_value(1);
+      if (power_pin_) {
+        power_pin_.set_value(1);
+      }
+    }
+
+    if (dithering_) {
+      // frame will be displayed with next refresh of dithering timer
+      frame.msg = msg;
+      frame.view = frame_view;
+    } else {
+      // frame for the other panel didn't arrive before the next one, don't delay this panel more
+      if (panel_bus_.is_pending(panel_id)) {
+        write_panels();
+      }
+      if (!panel_bus_.any_pending()) {
+        first_pending_time_ = panther_utils::steady_now_ns();
+        if (panel_write_deadline_ > 0.0) {
+          // first frame of a refresh, resetting the period re-arms the timer without allocating
+          pending_write_timer_.setPeriod(ros::WallDuration(panel_write_deadline_), true);
+        }
+      }
+      panel_bus_.set_panel(panel_id, frame_view);
+      pending_frame_stamps_[panel_id] = msg->header.stamp;
+
+      // frames of one refresh are published one after another, write them together. If the other
+      // frame doesn't arrive before the deadline, pending frame is written alone
+      if (panel_bus_.all_pending() || panel_write_deadline_ <= 0.0) {
+        write_panels();
+      }
+    }
+  }
+  PANTHER_TRACEPOINT(frame_cb_exit, panel_name);
+}
+
+void DriverNode::write_panels()
+{
+  const panther_utils::Stopwatch stopwatch;
+  panel_bus_.flush();
+  write_time_hist_.record(stopwatch.elapsed_ns());
+
+  const auto now = ros::Time::now();
+  for (std::size_t i = 0; i < pending_frame_stamps_.size(); i++) {
+    if (report_write_time_ && !pending_frame_stamps_[i].isZero()) {
+      sensor_msgs::TimeReference write_time;
+      write_time.header.stamp = now;
+      write_time.time_ref = pending_frame_stamps_[i];
+      write_time.source = panel_names_[i];
+      write_time_pub_.publish(write_time);
     }
-    panel.set_panel(msg->data);
+    pending_frame_stamps_[i] = ros::Time();
   }
 }
 
+void DriverNode::pending_write_timer_cb()
+{
+  // a callback queued before the timer was re-armed belongs to an already written refresh
+  const auto pending_time = (panther_utils::steady_now_ns() - first_pending_time_) * 1e-9;
+  if (panel_bus_.any_pending() && pending_time >= panel_write_deadline_) {
+    write_panels();
+  }
+}
+
+void DriverNode::dithering_timer_cb()
+{
+  const panther_utils::Stopwatch stopwatch;
+  if (front_frame_.msg) {
+    panel_bus_.set_panel(front_panel_id_, front_frame_.view, dither_phase_);
+  }
+  if (rear_frame_.msg) {
+    panel_bus_.set_panel(rear_panel_id_, rear_frame_.view, dither_phase_);
+  }
+  panel_bus_.flush();
+  dither_phase_++;
+  write_time_hist_.record(stopwatch.elapsed_ns());
+}
+
+void DriverNode::state_stream_timer_cb()
+{
+  if (!panels_initialised_) {
+    return;
+  }
+
+  // keyframe lets late subscribers recover full state
+  const auto now = ros::WallTime::now();
+  const bool keyframe = (now - last_state_keyframe_time_).toSec() >= state_stream_keyframe_period_;
+  if (keyframe) {
+    last_state_keyframe_time_ = now;
+  }
+
+  state_encoder_.encode(
+    {&panel_bus_.get_buffer(front_panel_id_), &panel_bus_.get_buffer(rear_panel_id_)}, keyframe,
+    state_msg_.data);
+  state_pub_.publish(state_msg_);
+}
+
+void DriverNode::bus_stats_timer_cb()
+{
+  std_msgs::Float64 utilization;
+  utilization.data = panel_bus_.take_utilization();
+  bus_utilization_pub_.publish(utilization);
+}
+
 }  // namespace panther_lights
\ No newline at end of file
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+
+from multiprocessing import Process
+from threading import Lock
+
+import numpy as np
+
+import rospy
+
+from sensor_msgs.msg import Image, TimeReference
+
+
+def _cpu_load_worker() -> None:
+    while True:
+        pass
+
+
+class LatencyBenchmarkNode:
+    def __init__(self, name: str) -> None:
+        rospy.init_node(name, anonymous=False)
+
+        self._lock = Lock()
+
+        self._duration = rospy.get_param('~duration', 30.0)
+        self._warmup = rospy.get_param('~warmup', 3.0)
+        cpu_load_workers = rospy.get_param('~cpu_load_workers', 0)
+
+        self._generated_frames = {'front': 0, 'rear': 0}
+        self._written_frames = {'front': 0, 'rear': 0}
+        self._latencies = []
+        self._measuring = False
+
+        self._load_processes = [
+            Process(target=_cpu_load_worker, daemon=True) for _ in range(cpu_load_workers)
+        ]
+        for process in self._load_processes:
+            process.start()
+
+        # -------------------------------
+        #   Subscribers
+        # -------------------------------
+
+        self._front_frame_sub = rospy.Subscriber(
+            'lights/driver/front_panel_frame', Image, self._frame_cb, 'front', queue_size=10
+        )
+        self._rear_frame_sub = rospy.Subscriber(
+            'lights/driver/rear_panel_frame', Image, self._frame_cb, 'rear', queue_size=10
+        )
+        self._write_time_sub = rospy.Subscriber(
+            'lights/driver/write_time', TimeReference, self._write_time_cb, queue_size=10
+        )
+
+        # -------------------------------
+        #   Timers
+        # -------------------------------
+
+        self._start_timer = rospy.Timer(
+            rospy.Duration(self._warmup), self._start_timer_cb, oneshot=True
+        )
+
+        rospy.loginfo(
+            f'[{rospy.get_name()}] Node started, measuring for {self._duration} s '
+            f'with {cpu_load_workers} CPU load workers'
+        )
+
+    def _frame_cb(self, msg: Image, panel: str) -> None:
+        with self._lock:
+            if self._measuring:
+                self._generated_frames[panel] += 1
+
+    def _write_time_cb(self, msg: TimeReference) -> None:
+        with self._lock:
+            if self._measuring and msg.source in self._written_frames:
+                self._written_frames[msg.source] += 1
+                self._latencies.append((msg.header.stamp - msg.time_ref).to_sec())
+
+    def _start_timer_cb(self, *args) -> None:
+        with self._lock:
+            self._measuring = True
+        self._stop_timer = rospy.Timer(
+            rospy.Duration(self._duration), self._stop_timer_cb, oneshot=True
+        )
+
+    def _stop_timer_cb(self, *args) -> None:
+        with self._lock:
+            self._measuring = False
+            self._report()
+
+        for process in self._load_processes:
+            process.terminate()
+        rospy.signal_shutdown('Benchmark finished')
+
+    def _report(self) -> None:
+        if not self._latencies:
+            rospy.logerr(
+                f'[{rospy.get_name()}] No frames were written, check if driver node '
+                f'has \'report_write_time\' parameter enabled'
+            )
+            return
+
+        latencies_ms = np.array(self._latencies) * 1e3
+        p50, p90, p99, p999 = np.percentile(latencies_ms, [50.0, 90.0, 99.0, 99.9])
+
+        report = (
+            f'[{rospy.get_name()}] Frame latency from generation to SPI write [ms]:\n'
+            f'  samples: {len(latencies_ms)}\n'
+            f'  p50: {p50:.3f}, p90: {p90:.3f}, p99: {p99:.3f}, p99.9: {p999:.3f}, '
+            f'max: {latencies_ms.max():.3f}\n'
+        )
+        for panel in ('front', 'rear'):
+            generated = self._generated_frames[panel]
+            written = self._written_frames[panel]
+            drop_rate = 1.0 - written / generated if generated else 0.0
+            report += (
+                f'  {panel} panel: generated {generated}, written {written}, '
+                f'drop rate: {drop_rate * 100.0:.2f}%\n'
+            )
+        rospy.loginfo(report)
+
+
+def main():
+    latency_benchmark_node = LatencyBenchmarkNode('lights_latency_benchmark_node')
+    rospy.spin()
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except rospy.ROSInterruptException:
+        pass
@@ -0,0 +1,96 @@
+#include <panther_lights/led_state_decoder.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <panther_lights/led_state_encoder.hpp>
+
+namespace panther_lights
+{
+
+bool LEDStateDecoder::decode(const std::vector<std::uint8_t> & frame)
+{
+  if (frame.size() < 5 || frame[0] != LEDStateEncoder::version) {
+    synchronized_ = false;
+    return false;
+  }
+
+  const bool keyframe = frame[1] & LEDStateEncoder::keyframe_flag;
+  const std::uint16_t sequence = std::uint16_t(frame[2] | (frame[3] << 8));
+  const std::size_t num_panels = frame[4];
+
+  // delta frame refers to the previous frame, which is missing
+  if (!keyframe && (!synchronized_ || sequence != std::uint16_t(last_sequence_ + 1) ||
+                    num_panels != panels_.size())) {
+    synchronized_ = false;
+    return false;
+  }
+
+  // panels are decoded aside, so a malformed frame doesn't corrupt the state
+  decoded_.resize(num_panels);
+  std::size_t pos = 5;
+  for (std::size_t i = 0; i < num_panels; i++) {
+    if (!decode_panel(frame, pos, keyframe ? nullptr : &panels_[i], decoded_[i])) {
+      synchronized_ = false;
+      return false;
+    }
+  }
+  if (pos != frame.size()) {
+    synchronized_ = false;
+    return false;
+  }
+
+  panels_.swap(decoded_);
+  last_sequence_ = sequence;
+  synchronized_ = true;
+  return true;
+}
+
+bool LEDStateDecoder::decode_panel(
+  const std::vector<std::uint8_t> & frame, std::size_t & pos,
+  const std::vector<std::uint8_t> * previous, std::vector<std::uint8_t> & panel)
+{
+  if (pos + 2 > frame.size()) {
+    return false;
+  }
+  const std::size_t num_led = frame[pos] | (frame[pos + 1] << 8);
+  pos += 2;
+
+  if (previous && previous->size() != 4 * num_led) {
+    return false;
+  }
+  panel.resize(4 * num_led);
+
+  std::size_t i = 0;
+  while (i < num_led) {
+    if (pos >= frame.size()) {
+      return false;
+    }
+    const std::uint8_t header = frame[pos++];
+    const std::size_t run = (header & 0x7F) + 1;
+    if (i + run > num_led) {
+      return false;
+    }
+
+    if (header & 0x80) {
+      if (!previous) {
+        return false;
+      }
+      std::copy(previous->begin() + 4 * i, previous->begin() + 4 * (i + run), panel.begin() + 4 * i);
+    } else {
+      if (pos + 4 > frame.size()) {
+        return false;
+      }
+      for (std::size_t j = i; j < i + run; j++) {
+        std::copy(frame.begin() + pos, frame.begin() + pos + 4, panel.begin() + 4 * j);
+      }
+      pos += 4;
+    }
+    i += run;
+  }
+  return true;
+}
+
+}  // namespace panther_lights
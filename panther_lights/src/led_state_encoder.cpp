@@ -0,0 +1,77 @@
+#include <panther_lights/led_state_encoder.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace panther_lights
+{
+
+void LEDStateEncoder::encode(
+  const std::vector<const std::vector<std::uint8_t> *> & panel_buffers, bool keyframe,
+  std::vector<std::uint8_t> & out)
+{
+  if (previous_.size() != panel_buffers.size()) {
+    keyframe = true;
+  } else {
+    for (std::size_t i = 0; i < panel_buffers.size(); i++) {
+      keyframe |= previous_[i].size() != panel_buffers[i]->size();
+    }
+  }
+
+  out.clear();
+  out.push_back(version);
+  out.push_back(keyframe ? keyframe_flag : 0);
+  out.push_back(std::uint8_t(sequence_ & 0xFF));
+  out.push_back(std::uint8_t(sequence_ >> 8));
+  out.push_back(std::uint8_t(panel_buffers.size()));
+  sequence_++;
+
+  previous_.resize(panel_buffers.size());
+  for (std::size_t i = 0; i < panel_buffers.size(); i++) {
+    encode_panel(*panel_buffers[i], keyframe ? nullptr : &previous_[i], out);
+    previous_[i] = *panel_buffers[i];
+  }
+}
+
+void LEDStateEncoder::encode_panel(
+  const std::vector<std::uint8_t> & buffer, const std::vector<std::uint8_t> * previous,
+  std::vector<std::uint8_t> & out)
+{
+  // skip start and end frames
+  const std::size_t num_led = buffer.size() < 8 ? 0 : (buffer.size() - 8) / 4;
+  out.push_back(std::uint8_t(num_led & 0xFF));
+  out.push_back(std::uint8_t(num_led >> 8));
+
+  const auto led = [](const std::vector<std::uint8_t> & b, const std::size_t i) {
+    return b.begin() + 4 + 4 * i;
+  };
+  const auto unchanged = [&](const std::size_t i) {
+    return previous && std::equal(led(buffer, i), led(buffer, i) + 4, led(*previous, i));
+  };
+
+  std::size_t i = 0;
+  while (i < num_led) {
+    std::size_t run = 1;
+    if (unchanged(i)) {
+      while (i + run < num_led && run < max_run_length_ && unchanged(i + run)) {
+        run++;
+      }
+      out.push_back(std::uint8_t(0x80 | (run - 1)));
+    } else {
+      while (i + run < num_led && run < max_run_length_ &&
+             std::equal(led(buffer, i), led(buffer, i) + 4, led(buffer, i + run))) {
+        run++;
+      }
+      const auto value = led(buffer, i);
+      out.push_back(std::uint8_t(run - 1));
+      // drop marker bits of the header, leaving brightness
+      out.push_back(value[0] & 0x1F);
+      out.insert(out.end(), value + 1, value + 4);
+    }
+    i += run;
+  }
+}
+
+}  // namespace panther_lights
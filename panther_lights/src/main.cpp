@@ -4,6 +4,8 @@
 
 #include <image_transport/image_transport.h>
 
+#include <panther_utils/realtime.hpp>
+
 int main(int argc, char ** argv)
 {
   ros::init(argc, argv, "lights_driver_node");
@@ -13,6 +15,11 @@ int main(int argc, char ** argv)
   auto it = std::make_shared<image_transport::ImageTransport>(*nh);
 
   try {
+    // frames are written to SPI from callbacks processed by this thread
+    panther_utils::RealtimeConfigurator realtime(*ph);
+    realtime.configure_process();
+    realtime.configure_thread("spi_writer");
+
     panther_lights::DriverNode driver_node(ph, nh, it);
     ros::spin();
   }
@@ -0,0 +1,63 @@
+#include <panther_lights/sim_apa102.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <ros/ros.h>
+
+#include <visualization_msgs/Marker.h>
+
+#include <panther_lights/apa102.hpp>
+
+namespace panther_lights
+{
+
+SimAPA102::SimAPA102(
+  const ros::Publisher & marker_pub, const std::string & frame_id, const std::string & ns,
+  const int num_led, const double led_spacing)
+: APA102(), marker_pub_(marker_pub)
+{
+  marker_.header.frame_id = frame_id;
+  marker_.ns = ns;
+  marker_.id = 0;
+  marker_.type = visualization_msgs::Marker::SPHERE_LIST;
+  marker_.action = visualization_msgs::Marker::ADD;
+  marker_.pose.orientation.w = 1.0;
+  marker_.scale.x = led_spacing;
+  marker_.scale.y = led_spacing;
+  marker_.scale.z = led_spacing;
+  marker_.points.resize(num_led);
+  marker_.colors.resize(num_led);
+
+  // LEDs are placed along x axis of the light link, centered at its origin
+  for (int i = 0; i < num_led; i++) {
+    marker_.points[i].x = (i - (num_led - 1) / 2.0) * led_spacing;
+    marker_.colors[i].a = 1.0;
+  }
+}
+
+void SimAPA102::transfer(const std::vector<std::uint8_t> & buffer) const
+{
+  // don't flood transport with frames that didn't change
+  if (buffer == last_buffer_) {
+    return;
+  }
+  last_buffer_ = buffer;
+
+  // decode LED frames skipping start frame, reverting color correction
+  const std::size_t num_led = std::min(marker_.colors.size(), (buffer.size() - 8) / 4);
+  for (std::size_t i = 0; i < num_led; i++) {
+    const std::size_t pad = 4 + i * 4;
+    const float brightness = float(buffer[pad] & 0x1F) / 31.0f;
+    marker_.colors[i].b = std::min(1.0f, float(buffer[pad + 1]) / corr_blue_) * brightness;
+    marker_.colors[i].g = std::min(1.0f, float(buffer[pad + 2]) / corr_green_) * brightness;
+    marker_.colors[i].r = std::min(1.0f, float(buffer[pad + 3]) / corr_red_) * brightness;
+  }
+
+  marker_.header.stamp = ros::Time::now();
+  marker_pub_.publish(marker_);
+}
+
+}  // namespace panther_lights
@@ -0,0 +1,135 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <panther_utils/allocation_counter.hpp>
+
+#include <panther_lights/apa102.hpp>
+#include <panther_lights/apa102_bus.hpp>
+#include <panther_lights/led_state_encoder.hpp>
+
+// allocations allowed per call once buffers were sized by the first frame
+constexpr std::size_t bus_set_panel_budget = 0;
+constexpr std::size_t state_encode_budget = 0;
+
+namespace
+{
+constexpr std::size_t num_led = 46;
+constexpr int iterations = 1000;
+
+std::vector<std::uint8_t> make_frame(const std::size_t channels)
+{
+  std::vector<std::uint8_t> frame(channels * num_led);
+  for (std::size_t i = 0; i < frame.size(); i++) {
+    frame[i] = std::uint8_t(i);
+  }
+  return frame;
+}
+}  // namespace
+
+class TestAllocations : public testing::TestWithParam<panther_lights::PixelFormat>
+{
+protected:
+  TestAllocations()
+  {
+    front_id_ = bus_.add_panel(front_);
+    rear_id_ = bus_.add_panel(rear_);
+  }
+
+  panther_lights::FrameView make_view(const std::vector<std::uint8_t> & frame) const
+  {
+    panther_lights::FrameView view;
+    view.data = frame.data();
+    view.num_led = num_led;
+    view.format = GetParam();
+    view.brightness = 128;
+    return view;
+  }
+
+  std::size_t channels() const
+  {
+    const auto format = GetParam();
+    return format == panther_lights::PixelFormat::RGBA8 ||
+               format == panther_lights::PixelFormat::BGRA8
+             ? 4
+             : 3;
+  }
+
+  panther_lights::NullAPA102 front_;
+  panther_lights::NullAPA102 rear_;
+  panther_lights::APA102Bus bus_;
+  std::size_t front_id_;
+  std::size_t rear_id_;
+};
+
+TEST_P(TestAllocations, BusSetPanel)
+{
+  const auto frame = make_frame(channels());
+  const auto view = make_view(frame);
+
+  bus_.set_panel(front_id_, view);
+  bus_.set_panel(rear_id_, view);
+  bus_.flush();
+
+  panther_utils::AllocationCounter counter;
+  for (int i = 0; i < iterations; i++) {
+    bus_.set_panel(front_id_, view);
+    bus_.set_panel(rear_id_, view);
+    bus_.flush();
+  }
+  EXPECT_LE(counter.count(), bus_set_panel_budget * 2 * iterations);
+}
+
+TEST_P(TestAllocations, BusSetPanelDithered)
+{
+  const auto frame = make_frame(channels());
+  const auto view = make_view(frame);
+
+  bus_.set_panel(front_id_, view, 0);
+  bus_.set_panel(rear_id_, view, 0);
+  bus_.flush();
+
+  panther_utils::AllocationCounter counter;
+  for (int i = 0; i < iterations; i++) {
+    bus_.set_panel(front_id_, view, std::uint8_t(i));
+    bus_.set_panel(rear_id_, view, std::uint8_t(i));
+    bus_.flush();
+  }
+  EXPECT_LE(counter.count(), bus_set_panel_budget * 2 * iterations);
+}
+
+TEST_P(TestAllocations, StateEncode)
+{
+  const auto frame = make_frame(channels());
+  const auto view = make_view(frame);
+  bus_.set_panel(front_id_, view);
+  bus_.set_panel(rear_id_, view);
+
+  panther_lights::LEDStateEncoder encoder;
+  std::vector<std::uint8_t> out;
+  const std::vector<const std::vector<std::uint8_t> *> buffers = {
+    &bus_.get_buffer(front_id_), &bus_.get_buffer(rear_id_)};
+  // keyframe is the largest, so it sizes the output
+  encoder.encode(buffers, true, out);
+  encoder.encode(buffers, false, out);
+
+  panther_utils::AllocationCounter counter;
+  for (int i = 0; i < iterations; i++) {
+    encoder.encode(buffers, i % 10 == 0, out);
+  }
+  EXPECT_LE(counter.count(), state_encode_budget * iterations);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  PixelFormats, TestAllocations,
+  testing::Values(
+    panther_lights::PixelFormat::RGB8, panther_lights::PixelFormat::BGR8,
+    panther_lights::PixelFormat::RGBA8, panther_lights::PixelFormat::BGRA8));
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+#include <boost/make_shared.hpp>
+#include <gtest/gtest.h>
+
+#include <ros/ros.h>
+
+#include <image_transport/image_transport.h>
+#include <sensor_msgs/Image.h>
+
+#include <panther_utils/allocation_counter.hpp>
+
+#include <panther_lights/driver_node.hpp>
+
+// allocations allowed per frame_cb call once the driver handled its first frames
+constexpr std::size_t frame_cb_budget = 0;
+
+namespace
+{
+constexpr int num_led = 46;
+constexpr int iterations = 1000;
+
+sensor_msgs::Image::Ptr make_frame()
+{
+  auto msg = boost::make_shared<sensor_msgs::Image>();
+  msg->header.stamp = ros::Time::now();
+  msg->encoding = "rgb8; brightness=128";
+  msg->height = 1;
+  msg->width = num_led;
+  msg->step = 3 * num_led;
+  msg->data.resize(msg->step, 100);
+  return msg;
+}
+}  // namespace
+
+namespace panther_lights
+{
+
+// befriended by DriverNode to call frame_cb() directly, bypassing roscpp deserialization
+class TestDriverNodeAllocations : public testing::Test
+{
+protected:
+  TestDriverNodeAllocations()
+  {
+    ph_ = std::make_shared<ros::NodeHandle>("~");
+    nh_ = std::make_shared<ros::NodeHandle>();
+    it_ = std::make_shared<image_transport::ImageTransport>(*nh_);
+
+    // driver waits in its constructor until a frame arrives
+    auto frame_pub = nh_->advertise<sensor_msgs::Image>("lights/driver/front_panel_frame", 1);
+    std::atomic_bool constructed = false;
+    std::thread publisher([&] {
+      while (!constructed && ros::ok()) {
+        frame_pub.publish(make_frame());
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    });
+    driver_node_ = std::make_unique<DriverNode>(ph_, nh_, it_);
+    constructed = true;
+    publisher.join();
+  }
+
+  void front_frame_cb(const sensor_msgs::Image::ConstPtr & msg)
+  {
+    auto & node = *driver_node_;
+    node.frame_cb(msg, node.front_panel_id_, node.front_frame_, ros::Time(), "front");
+  }
+
+  void rear_frame_cb(const sensor_msgs::Image::ConstPtr & msg)
+  {
+    auto & node = *driver_node_;
+    node.frame_cb(msg, node.rear_panel_id_, node.rear_frame_, ros::Time(), "rear");
+  }
+
+  ros::SteadyTimer & pending_write_timer() { return driver_node_->pending_write_timer_; }
+
+  std::shared_ptr<ros::NodeHandle> ph_;
+  std::shared_ptr<ros::NodeHandle> nh_;
+  std::shared_ptr<image_transport::ImageTransport> it_;
+  std::unique_ptr<DriverNode> driver_node_;
+};
+
+TEST_F(TestDriverNodeAllocations, FrameCbBothPanels)
+{
+  const auto front = make_frame();
+  const auto rear = make_frame();
+  front_frame_cb(front);
+  rear_frame_cb(rear);
+
+  panther_utils::AllocationCounter counter;
+  for (int i = 0; i < iterations; i++) {
+    front_frame_cb(front);
+    rear_frame_cb(rear);
+  }
+  EXPECT_LE(counter.count(), frame_cb_budget * 2 * iterations);
+}
+
+TEST_F(TestDriverNodeAllocations, FrameCbSinglePanel)
+{
+  // each frame replaces the pending one, so the previous frame is written alone and every call
+  // re-arms the one-shot pending write timer
+  ASSERT_TRUE(pending_write_timer().isValid());
+  const auto front = make_frame();
+  front_frame_cb(front);
+  front_frame_cb(front);
+
+  panther_utils::AllocationCounter counter;
+  for (int i = 0; i < iterations; i++) {
+    front_frame_cb(front);
+  }
+  EXPECT_LE(counter.count(), frame_cb_budget * iterations);
+}
+
+}  // namespace panther_lights
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "test_driver_node_allocations");
+  return RUN_ALL_TESTS();
+}
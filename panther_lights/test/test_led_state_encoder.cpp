@@ -0,0 +1,157 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <panther_lights/led_state_decoder.hpp>
+#include <panther_lights/led_state_encoder.hpp>
+
+namespace
+{
+// APA102 buffer with start and end frames, LED i has value derived from pattern(i)
+template <typename F>
+std::vector<std::uint8_t> make_buffer(const std::size_t num_led, F pattern)
+{
+  std::vector<std::uint8_t> buffer(8 + 4 * num_led, 0);
+  for (std::size_t i = 0; i < num_led; i++) {
+    const std::uint8_t value = pattern(i);
+    buffer[4 + 4 * i] = 0xE0 | (value & 0x1F);
+    buffer[5 + 4 * i] = value;
+    buffer[6 + 4 * i] = std::uint8_t(value + 1);
+    buffer[7 + 4 * i] = std::uint8_t(value + 2);
+  }
+  return buffer;
+}
+
+// LED values as returned by the decoder
+std::vector<std::uint8_t> leds(const std::vector<std::uint8_t> & buffer)
+{
+  std::vector<std::uint8_t> values(buffer.begin() + 4, buffer.end() - 4);
+  for (std::size_t i = 0; i < values.size(); i += 4) {
+    values[i] &= 0x1F;
+  }
+  return values;
+}
+}  // namespace
+
+TEST(TestLEDStateEncoder, KeyframeRoundTrip)
+{
+  const auto front = make_buffer(46, [](std::size_t i) { return i < 20 ? 3 : i; });
+  const auto rear = make_buffer(46, [](std::size_t) { return 7; });
+
+  panther_lights::LEDStateEncoder encoder;
+  panther_lights::LEDStateDecoder decoder;
+  std::vector<std::uint8_t> frame;
+  encoder.encode({&front, &rear}, true, frame);
+
+  ASSERT_TRUE(decoder.decode(frame));
+  EXPECT_TRUE(decoder.synchronized());
+  ASSERT_EQ(decoder.panels().size(), 2u);
+  EXPECT_EQ(decoder.panels()[0], leds(front));
+  EXPECT_EQ(decoder.panels()[1], leds(rear));
+}
+
+TEST(TestLEDStateEncoder, DeltaFrameRoundTrip)
+{
+  auto front = make_buffer(46, [](std::size_t) { return 1; });
+  const auto rear = make_buffer(46, [](std::size_t) { return 2; });
+
+  panther_lights::LEDStateEncoder encoder;
+  panther_lights::LEDStateDecoder decoder;
+  std::vector<std::uint8_t> frame;
+  encoder.encode({&front, &rear}, true, frame);
+  ASSERT_TRUE(decoder.decode(frame));
+
+  front = make_buffer(46, [](std::size_t i) { return i == 10 ? 9 : 1; });
+  encoder.encode({&front, &rear}, false, frame);
+  EXPECT_FALSE(frame[1] & panther_lights::LEDStateEncoder::keyframe_flag);
+
+  ASSERT_TRUE(decoder.decode(frame));
+  EXPECT_EQ(decoder.panels()[0], leds(front));
+  EXPECT_EQ(decoder.panels()[1], leds(rear));
+}
+
+TEST(TestLEDStateEncoder, MoreThan255LEDs)
+{
+  const auto panel = make_buffer(300, [](std::size_t i) { return i / 50; });
+
+  panther_lights::LEDStateEncoder encoder;
+  panther_lights::LEDStateDecoder decoder;
+  std::vector<std::uint8_t> frame;
+  encoder.encode({&panel}, true, frame);
+
+  ASSERT_TRUE(decoder.decode(frame));
+  ASSERT_EQ(decoder.panels().size(), 1u);
+  EXPECT_EQ(decoder.panels()[0], leds(panel));
+}
+
+TEST(TestLEDStateEncoder, LostFrameWaitsForKeyframe)
+{
+  panther_lights::LEDStateEncoder encoder;
+  panther_lights::LEDStateDecoder decoder;
+  std::vector<std::uint8_t> frame;
+
+  auto panel = make_buffer(46, [](std::size_t) { return 1; });
+  encoder.encode({&panel}, true, frame);
+  ASSERT_TRUE(decoder.decode(frame));
+
+  // lost delta frame
+  panel = make_buffer(46, [](std::size_t i) { return i < 5 ? 2 : 1; });
+  encoder.encode({&panel}, false, frame);
+
+  panel = make_buffer(46, [](std::size_t i) { return i < 5 ? 2 : 3; });
+  encoder.encode({&panel}, false, frame);
+  EXPECT_FALSE(decoder.decode(frame));
+  EXPECT_FALSE(decoder.synchronized());
+
+  // next delta frame can't be applied either
+  encoder.encode({&panel}, false, frame);
+  EXPECT_FALSE(decoder.decode(frame));
+
+  encoder.encode({&panel}, true, frame);
+  ASSERT_TRUE(decoder.decode(frame));
+  EXPECT_TRUE(decoder.synchronized());
+  EXPECT_EQ(decoder.panels()[0], leds(panel));
+}
+
+TEST(TestLEDStateEncoder, SequenceWrapsAround)
+{
+  panther_lights::LEDStateEncoder encoder;
+  panther_lights::LEDStateDecoder decoder;
+  std::vector<std::uint8_t> frame;
+
+  const auto panel = make_buffer(4, [](std::size_t) { return 1; });
+  for (std::size_t i = 0; i < 70000; i++) {
+    encoder.encode({&panel}, i == 0, frame);
+    ASSERT_TRUE(decoder.decode(frame)) << "frame " << i;
+  }
+}
+
+TEST(TestLEDStateEncoder, MalformedFrameIsRejected)
+{
+  panther_lights::LEDStateEncoder encoder;
+  panther_lights::LEDStateDecoder decoder;
+  std::vector<std::uint8_t> frame;
+
+  const auto panel = make_buffer(46, [](std::size_t i) { return i; });
+  encoder.encode({&panel}, true, frame);
+  ASSERT_TRUE(decoder.decode(frame));
+
+  auto truncated = frame;
+  truncated.pop_back();
+  EXPECT_FALSE(decoder.decode(truncated));
+  EXPECT_FALSE(decoder.synchronized());
+  // state of the last valid frame is kept
+  EXPECT_EQ(decoder.panels()[0], leds(panel));
+
+  auto wrong_version = frame;
+  wrong_version[0]++;
+  EXPECT_FALSE(decoder.decode(wrong_version));
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,90 @@
+#ifndef PANTHER_MANAGER_BLACKBOARD_TELEMETRY_HPP_
+#define PANTHER_MANAGER_BLACKBOARD_TELEMETRY_HPP_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <behaviortree_cpp/blackboard.h>
+
+#include <ros/ros.h>
+
+#include <std_msgs/Float64MultiArray.h>
+
+namespace panther_manager
+{
+
+// publishes blackboard entries that changed since the last publish as pairs of entry index and
+// value. Names of entries are published once on a latched topic, their order defines indexes
+class BlackboardTelemetry
+{
+public:
+  BlackboardTelemetry(
+    const std::shared_ptr<ros::NodeHandle> & ph, const double rate, const double keyframe_period);
+
+  // entries have to be added before start(), value of entry is converted to double
+  template <typename T>
+  void add_entry(
+    const std::string & tree, const BT::Blackboard::Ptr & blackboard, const std::string & key)
+  {
+    Entry entry;
+    entry.name = tree + "/" + key;
+    entry.read = [blackboard, key](double & value) {
+      T bb_value;
+      if (!blackboard->get<T>(key, bb_value)) {
+        return false;
+      }
+      if constexpr (std::is_arithmetic_v<T>) {
+        value = static_cast<double>(bb_value);
+      } else {
+        // pair with bool flag and description, eg. signal_shutdown
+        value = static_cast<double>(bb_value.first);
+      }
+      return true;
+    };
+    entries_.push_back(std::move(entry));
+  }
+
+  // entry with value returned by read, for state kept outside of blackboards
+  void add_value(const std::string & group, const std::string & key, std::function<double()> read)
+  {
+    Entry entry;
+    entry.name = group + "/" + key;
+    entry.read = [read = std::move(read)](double & value) {
+      value = read();
+      return true;
+    };
+    entries_.push_back(std::move(entry));
+  }
+
+  void start();
+
+private:
+  struct Entry
+  {
+    std::string name;
+    std::function<bool(double &)> read;
+    double last_value = 0.0;
+    bool published = false;
+  };
+
+  double rate_;
+  double keyframe_period_;
+  ros::Time last_keyframe_time_;
+  std::vector<Entry> entries_;
+  std_msgs::Float64MultiArray msg_;
+
+  std::shared_ptr<ros::NodeHandle> ph_;
+  ros::Publisher keys_pub_;
+  ros::Publisher telemetry_pub_;
+  ros::Timer telemetry_timer_;
+
+  void telemetry_timer_cb();
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_BLACKBOARD_TELEMETRY_HPP_
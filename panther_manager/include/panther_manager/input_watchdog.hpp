@@ -0,0 +1,64 @@
+#ifndef PANTHER_MANAGER_INPUT_WATCHDOG_HPP_
+#define PANTHER_MANAGER_INPUT_WATCHDOG_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ros/ros.h>
+
+#include <diagnostic_msgs/DiagnosticArray.h>
+
+namespace panther_manager
+{
+
+// tracks arrival of input messages. Each input has a one-shot timer armed for its deadline, when it
+// expires before a new message arrives the input is marked as stale and diagnostics are published.
+// Timers fire at most once per max age while messages arrive, so there is no polling.
+class InputWatchdog
+{
+public:
+  explicit InputWatchdog(const std::shared_ptr<ros::NodeHandle> & nh);
+
+  // returns ID of the input used with notify(), input with max age 0 is never stale
+  std::size_t add_input(const std::string & name, const ros::Duration & max_age);
+
+  // arms timers of all inputs, inputs have to be added before
+  void start();
+
+  // has to be called on each arrival of a message
+  void notify(const std::size_t id);
+
+  bool is_stale(const std::size_t id) const { return inputs_[id]->stale; }
+
+private:
+  struct Input
+  {
+    std::string name;
+    ros::Duration max_age;
+    std::atomic<std::uint64_t> last_arrival_ns{0};
+    std::atomic_bool stale{false};
+    ros::Timer timer;
+  };
+
+  std::string node_name_;
+  std::vector<std::unique_ptr<Input>> inputs_;
+  std::mutex diagnostics_mutex_;
+  std::mutex timers_mutex_;
+  diagnostic_msgs::DiagnosticArray diagnostics_msg_;
+
+  std::shared_ptr<ros::NodeHandle> nh_;
+  ros::Publisher diagnostics_pub_;
+
+  void deadline_timer_cb(Input & input);
+  void rearm_timer(Input & input, const ros::Duration & timeout);
+  void publish_diagnostics();
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_INPUT_WATCHDOG_HPP_
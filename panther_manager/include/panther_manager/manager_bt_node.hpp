@@ -2,24 +2,41 @@
 #define PANTHER_MANAGER_MANAGER_BT_NODE_HPP_
 
 #include <any>
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
-#include <optional>
 #include <string>
+#include <thread>
 
 #include <behaviortree_cpp/bt_factory.h>
 #include <behaviortree_cpp/loggers/groot2_publisher.h>
 
+#include <ros/callback_queue.h>
+#include <ros/message_traits.h>
 #include <ros/ros.h>
 
 #include <sensor_msgs/BatteryState.h>
 #include <std_msgs/Bool.h>
+#include <std_srvs/Trigger.h>
 
 #include <panther_msgs/DriverState.h>
 #include <panther_msgs/IOState.h>
 #include <panther_msgs/SystemStatus.h>
 
-#include <panther_manager/moving_average.hpp>
+#include <panther_utils/async_logger.hpp>
+#include <panther_utils/realtime.hpp>
+#include <panther_utils/seqlock.hpp>
+
+#include <panther_manager/blackboard_telemetry.hpp>
+#include <panther_manager/input_watchdog.hpp>
+#include <panther_manager/plugins/event_channel.hpp>
+#include <panther_manager/plugins/gpio_lines.hpp>
+#include <panther_manager/plugins/led_animation_dispatcher.hpp>
+#include <panther_manager/plugins/reactor.hpp>
+#include <panther_manager/plugins/ssh_key_store.hpp>
+#include <panther_manager/state_snapshot.hpp>
+#include <panther_manager/time_window_average.hpp>
 
 namespace panther_manager
 {
@@ -29,27 +46,64 @@ class ManagerBTNode
 public:
   ManagerBTNode(
     const std::shared_ptr<ros::NodeHandle> & nh, const std::shared_ptr<ros::NodeHandle> & ph);
-  ~ManagerBTNode() {}
+  ~ManagerBTNode();
 
 private:
+  struct BatteryInput
+  {
+    bool received;
+    unsigned status;
+    unsigned health;
+  };
+
+  struct IOInput
+  {
+    bool received;
+    bool aux_power;
+    bool fan;
+  };
+
   static constexpr float critical_bat_temp_ = 55.0;
   static constexpr float fatal_bat_temp_ = 62.0;
+  static constexpr std::int8_t e_stop_unknown_ = -1;
 
   bool launch_shutdown_tree_;
+  bool safety_reflex_;
   float update_charging_anim_step_;
+  // last value written to battery_percent_round, NaN before the first tick
+  double battery_percent_round_;
+  std::size_t battery_input_id_;
+  std::size_t driver_state_input_id_;
+  std::size_t io_state_input_id_;
+  std::size_t system_status_input_id_;
   std::string node_name_;
-  std::optional<unsigned> battery_status_;
-  std::optional<unsigned> battery_health_;
-  std::optional<bool> e_stop_state_;
-  std::optional<panther_msgs::IOState::ConstPtr> io_state_;
+  // written by subscriber callbacks and read by tree ticks running on other threads
+  // e_stop_unknown_ until the first E-stop message, then 0 or 1
+  std::atomic<std::int8_t> e_stop_state_{e_stop_unknown_};
+  panther_utils::SeqLock<BatteryInput> battery_input_;
+  panther_utils::SeqLock<IOInput> io_input_;
+  // steady time in ns at which critical condition was detected, 0 if there is none pending
+  std::atomic<std::int64_t> critical_condition_time_{0};
+  std::atomic_bool reflex_triggered_{false};
+  std::atomic_bool shutdown_started_{false};
 
   ros::Subscriber battery_sub_;
   ros::Subscriber driver_state_sub_;
   ros::Subscriber e_stop_sub_;
   ros::Subscriber io_state_sub_;
   ros::Subscriber system_status_sub_;
+  ros::Publisher reflex_reaction_time_pub_;
+  ros::Publisher tree_reaction_time_pub_;
+  ros::ServiceClient e_stop_trigger_client_;
   ros::Timer lights_tree_timer_;
   ros::Timer safety_tree_timer_;
+  ros::WallTimer state_snapshot_timer_;
+  ros::CallbackQueue lights_tree_queue_;
+  ros::CallbackQueue safety_tree_queue_;
+  std::thread lights_tree_thread_;
+  std::thread safety_tree_thread_;
+  std::thread event_thread_;
+  panther_utils::RealtimeConfigurator realtime_;
   std::shared_ptr<ros::NodeHandle> nh_;
   std::shared_ptr<ros::NodeHandle> ph_;
 
@@ -66,22 +120,50 @@ private:
   std::unique_ptr<BT::Groot2Publisher> lights_bt_publisher_;
   std::unique_ptr<BT::Groot2Publisher> safety_bt_publisher_;
   std::unique_ptr<BT::Groot2Publisher> shutdown_bt_publisher_;
-
-  std::unique_ptr<MovingAverage<double>> battery_temp_ma_;
-  std::unique_ptr<MovingAverage<double>> battery_percent_ma_;
-  std::unique_ptr<MovingAverage<double>> cpu_temp_ma_;
-  std::unique_ptr<MovingAverage<double>> front_driver_temp_ma_;
-  std::unique_ptr<MovingAverage<double>> rear_driver_temp_ma_;
+  std::shared_ptr<EventChannel> event_channel_;
+  std::shared_ptr<GPIOLines> gpio_lines_;
+  std::shared_ptr<LEDAnimationDispatcher> led_animation_dispatcher_;
+  std::shared_ptr<Reactor> reactor_;
+  std::shared_ptr<SSHKeyStore> ssh_key_store_;
+  std::unique_ptr<BlackboardTelemetry> telemetry_;
+  std::unique_ptr<InputWatchdog> input_watchdog_;
+  std::unique_ptr<StateSnapshot> state_snapshot_;
+  panther_utils::AsyncLogger & logger_ = panther_utils::AsyncLogger::instance();
+
+  std::unique_ptr<TimeWindowAverage<double>> battery_temp_filter_;
+  std::unique_ptr<TimeWindowAverage<double>> battery_percent_filter_;
+  std::unique_ptr<TimeWindowAverage<double>> cpu_temp_filter_;
+  std::unique_ptr<TimeWindowAverage<double>> front_driver_temp_filter_;
+  std::unique_ptr<TimeWindowAverage<double>> rear_driver_temp_filter_;
 
   void battery_cb(const sensor_msgs::BatteryState::ConstPtr & battery);
   void driver_state_cb(const panther_msgs::DriverState::ConstPtr & driver_state);
   void e_stop_cb(const std_msgs::Bool::ConstPtr & e_stop);
   void io_state_cb(const panther_msgs::IOState::ConstPtr & io_state);
   void system_status_cb(const panther_msgs::SystemStatus::ConstPtr & system_status);
+  void safety_reflex(const unsigned battery_health);
   void safety_tree_timer_cb();
   void lights_tree_timer_cb();
+  void state_snapshot_timer_cb();
+  void restore_state(const double max_age);
+  void publish_reaction_time(const ros::Publisher & pub, const std::int64_t detection_time);
   void shutdown_robot(const std::string & reason);
+  void tree_thread(ros::CallbackQueue & queue, const std::string & realtime_role);
+  void event_thread();
+  void handle_event(const ManagerEvent & event);
   BT::NodeConfig create_bt_config(const std::map<std::string, std::any> & bb_values = {}) const;
+
+  // message stamp if it is set, otherwise time of arrival
+  template <typename MessageT>
+  static ros::Time get_stamp(const MessageT & msg)
+  {
+    if constexpr (ros::message_traits::HasHeader<MessageT>::value) {
+      if (!msg.header.stamp.isZero()) {
+        return msg.header.stamp;
+      }
+    }
+    return ros::Time::now();
+  }
 };
 
 }  // namespace panther_manager
@@ -9,6 +9,7 @@
 
 #include <std_srvs/SetBool.h>
 
+#include <panther_manager/plugins/cached_input_port.hpp>
 #include <panther_manager/plugins/ros_service_node.hpp>
 
 namespace panther_manager
@@ -20,7 +21,7 @@ public:
   CallSetBoolService(
     const std::string & name, const BT::NodeConfig & conf,
     const std::shared_ptr<ros::NodeHandle> & nh)
-  : RosServiceNode(name, conf, nh)
+  : RosServiceNode(name, conf, nh), data_port_(*this, "data")
   {
   }
 
@@ -31,6 +32,9 @@ public:
 
   void update_request(std_srvs::SetBool::Request & request) override;
   virtual BT::NodeStatus on_response(const std_srvs::SetBool::Response & response);
+
+private:
+  CachedInputPort<bool> data_port_;
 };
 
 }  // namespace panther_manager
@@ -9,6 +9,7 @@
 
 #include <panther_msgs/SetLEDAnimation.h>
 
+#include <panther_manager/plugins/cached_input_port.hpp>
 #include <panther_manager/plugins/ros_service_node.hpp>
 
 namespace panther_manager
@@ -20,7 +21,10 @@ public:
   CallSetLedAnimationService(
     const std::string & name, const BT::NodeConfig & conf,
     const std::shared_ptr<ros::NodeHandle> & nh)
-  : RosServiceNode(name, conf, nh)
+  : RosServiceNode(name, conf, nh),
+    id_port_(*this, "id"),
+    param_port_(*this, "param"),
+    repeating_port_(*this, "repeating")
   {
   }
 
@@ -35,6 +39,11 @@ public:
 
   void update_request(panther_msgs::SetLEDAnimation::Request & request) override;
   virtual BT::NodeStatus on_response(const panther_msgs::SetLEDAnimation::Response & response);
+
+private:
+  CachedInputPort<unsigned> id_port_;
+  CachedInputPort<std::string> param_port_;
+  CachedInputPort<bool> repeating_port_;
 };
 
 }  // namespace panther_manager
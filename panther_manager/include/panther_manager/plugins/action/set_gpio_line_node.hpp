@@ -0,0 +1,37 @@
+#ifndef PANTHER_MANAGER_SET_GPIO_LINE_NODE_HPP_
+#define PANTHER_MANAGER_SET_GPIO_LINE_NODE_HPP_
+
+#include <memory>
+#include <string>
+
+#include <behaviortree_cpp/action_node.h>
+#include <behaviortree_cpp/basic_types.h>
+#include <behaviortree_cpp/tree_node.h>
+
+#include <panther_manager/plugins/gpio_lines.hpp>
+
+namespace panther_manager
+{
+
+class SetGPIOLine : public BT::SyncActionNode
+{
+public:
+  explicit SetGPIOLine(const std::string & name, const BT::NodeConfig & conf);
+
+  static BT::PortsList providedPorts()
+  {
+    return {
+      BT::InputPort<std::string>("line_name", "name of GPIO line owned by the manager"),
+      BT::InputPort<bool>("data", "true / false value"),
+    };
+  }
+
+private:
+  std::shared_ptr<GPIOLines> gpio_lines_;
+
+  virtual BT::NodeStatus tick() override;
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_SET_GPIO_LINE_NODE_HPP_
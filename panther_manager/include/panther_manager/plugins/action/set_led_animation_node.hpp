@@ -0,0 +1,54 @@
+#ifndef PANTHER_MANAGER_SET_LED_ANIMATION_NODE_HPP_
+#define PANTHER_MANAGER_SET_LED_ANIMATION_NODE_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <behaviortree_cpp/action_node.h>
+#include <behaviortree_cpp/basic_types.h>
+#include <behaviortree_cpp/tree_node.h>
+
+#include <panther_manager/plugins/cached_input_port.hpp>
+#include <panther_manager/plugins/led_animation_dispatcher.hpp>
+
+namespace panther_manager
+{
+
+// queues animation request in LED animation dispatcher found on blackboard. Requests queued during
+// one tick are sent as a single service call after the tick. With confirm set to false node
+// succeeds right away and the dispatcher retries a failed request, otherwise it is RUNNING until
+// the controller accepts the animation and fails if the animation was not shown.
+class SetLedAnimation : public BT::StatefulActionNode
+{
+public:
+  explicit SetLedAnimation(const std::string & name, const BT::NodeConfig & conf);
+
+  static BT::PortsList providedPorts()
+  {
+    return {
+      BT::InputPort<unsigned>("id", "animation ID"),
+      BT::InputPort<std::string>("param", "", "optional parameter"),
+      BT::InputPort<bool>("repeating", false, "indicates if animation should repeat"),
+      BT::InputPort<bool>(
+        "confirm", false, "wait until controller confirms that animation was set"),
+    };
+  }
+
+private:
+  bool confirm_;
+  std::uint64_t ticket_;
+  CachedInputPort<unsigned> id_port_;
+  CachedInputPort<std::string> param_port_;
+  CachedInputPort<bool> repeating_port_;
+  CachedInputPort<bool> confirm_port_;
+  std::shared_ptr<LEDAnimationDispatcher> dispatcher_;
+
+  BT::NodeStatus onStart() override;
+  BT::NodeStatus onRunning() override;
+  void onHalted() override {}
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_SET_LED_ANIMATION_NODE_HPP_
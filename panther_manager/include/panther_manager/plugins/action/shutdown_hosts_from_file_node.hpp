@@ -20,6 +20,7 @@ public:
   ShutdownHostsFromFile(const std::string & name, const BT::NodeConfig & conf)
   : ShutdownHosts(name, conf)
   {
+    preload_ssh_keys();
   }
 
   static BT::PortsList providedPorts()
@@ -32,6 +33,7 @@ public:
 
 private:
   void update_hosts(std::vector<std::shared_ptr<ShutdownHost>> & hosts) override;
+  void preload_ssh_keys();
 };
 
 }  // namespace panther_manager
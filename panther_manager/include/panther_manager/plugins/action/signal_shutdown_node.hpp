@@ -1,22 +1,22 @@
 #ifndef PANTHER_MANAGER_SIGNAL_SHUTDOWN_NODE_HPP_
 #define PANTHER_MANAGER_SIGNAL_SHUTDOWN_NODE_HPP_
 
+#include <memory>
 #include <string>
 
 #include <behaviortree_cpp/action_node.h>
 #include <behaviortree_cpp/basic_types.h>
 #include <behaviortree_cpp/tree_node.h>
 
+#include <panther_manager/plugins/event_channel.hpp>
+
 namespace panther_manager
 {
 
 class SignalShutdown : public BT::SyncActionNode
 {
 public:
-  explicit SignalShutdown(const std::string & name, const BT::NodeConfig & conf)
-  : BT::SyncActionNode(name, conf)
-  {
-  }
+  explicit SignalShutdown(const std::string & name, const BT::NodeConfig & conf);
 
   static BT::PortsList providedPorts()
   {
@@ -26,6 +26,8 @@ public:
   }
 
 private:
+  std::shared_ptr<EventChannel> event_channel_;
+
   virtual BT::NodeStatus tick() override;
 };
 
@@ -0,0 +1,133 @@
+#ifndef PANTHER_MANAGER_ASYNC_PING_HPP_
+#define PANTHER_MANAGER_ASYNC_PING_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/ip_icmp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <panther_manager/plugins/reactor.hpp>
+
+namespace panther_manager
+{
+
+enum class PingResult {
+  PENDING = 0,
+  REACHABLE,
+  UNREACHABLE,
+};
+
+// sends a single ICMP echo request over an unprivileged ICMP socket, reply and timeout are handled
+// by the reactor thread. Requires net.ipv4.ping_group_range to include the group of the process
+class AsyncPing
+{
+public:
+  explicit AsyncPing(const std::shared_ptr<Reactor> & reactor) : reactor_(reactor) {}
+
+  ~AsyncPing() { cancel(); }
+
+  AsyncPing(const AsyncPing &) = delete;
+  AsyncPing & operator=(const AsyncPing &) = delete;
+
+  // returns false if the request couldn't be sent, eg. ICMP sockets are not permitted or ip is not
+  // an IPv4 address. Pending request is cancelled
+  bool start(const std::string & ip, const double timeout)
+  {
+    cancel();
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    if (inet_pton(AF_INET, ip.c_str(), &addr.sin_addr) != 1) {
+      return false;
+    }
+
+    socket_fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_ICMP);
+    if (socket_fd_ < 0) {
+      return false;
+    }
+
+    // identifier and checksum are filled by the kernel
+    icmphdr request = {};
+    request.type = ICMP_ECHO;
+    request.un.echo.sequence = htons(++sequence_);
+    if (
+      sendto(
+        socket_fd_, &request, sizeof(request), 0, reinterpret_cast<sockaddr *>(&addr),
+        sizeof(addr)) < 0) {
+      close(socket_fd_);
+      socket_fd_ = -1;
+      return false;
+    }
+
+    result_ = PingResult::PENDING;
+    try {
+      reactor_->add(socket_fd_, EPOLLIN, [this](std::uint32_t) { on_reply(); });
+      timer_fd_ = reactor_->add_timer(timeout, [this](std::uint32_t) { on_timeout(); });
+    } catch (const std::runtime_error &) {
+      cancel();
+      return false;
+    }
+    return true;
+  }
+
+  // once the request finished, its socket and timer are released, so idle requests don't hold
+  // file descriptors
+  PingResult get_result()
+  {
+    const PingResult result = result_;
+    if (result != PingResult::PENDING) {
+      cancel();
+    }
+    return result;
+  }
+
+  void cancel()
+  {
+    if (timer_fd_ >= 0) {
+      reactor_->remove_timer(timer_fd_);
+      timer_fd_ = -1;
+    }
+    if (socket_fd_ >= 0) {
+      reactor_->remove(socket_fd_);
+      close(socket_fd_);
+      socket_fd_ = -1;
+    }
+  }
+
+private:
+  int socket_fd_ = -1;
+  int timer_fd_ = -1;
+  std::uint16_t sequence_ = 0;
+  std::atomic<PingResult> result_{PingResult::UNREACHABLE};
+  std::shared_ptr<Reactor> reactor_;
+
+  void on_reply()
+  {
+    icmphdr reply;
+    while (recv(socket_fd_, &reply, sizeof(reply), 0) >= static_cast<ssize_t>(sizeof(reply))) {
+      if (reply.type == ICMP_ECHOREPLY && reply.un.echo.sequence == htons(sequence_)) {
+        PingResult expected = PingResult::PENDING;
+        result_.compare_exchange_strong(expected, PingResult::REACHABLE);
+        return;
+      }
+    }
+  }
+
+  void on_timeout()
+  {
+    PingResult expected = PingResult::PENDING;
+    result_.compare_exchange_strong(expected, PingResult::UNREACHABLE);
+  }
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_ASYNC_PING_HPP_
@@ -0,0 +1,69 @@
+#ifndef PANTHER_MANAGER_CACHED_INPUT_PORT_HPP_
+#define PANTHER_MANAGER_CACHED_INPUT_PORT_HPP_
+
+#include <optional>
+#include <string>
+
+#include <behaviortree_cpp/basic_types.h>
+#include <behaviortree_cpp/tree_node.h>
+
+namespace panther_manager
+{
+
+// input port whose value is parsed once at construction if it is a literal in the XML. Ports
+// remapped to blackboard entries are still read on each call, but the entry key is resolved once,
+// as getInput() builds a string from it on each call
+template <typename T>
+class CachedInputPort
+{
+public:
+  CachedInputPort(const BT::TreeNode & node, const std::string & name) : name_(name)
+  {
+    const auto & ports = node.config().input_ports;
+    const auto it = ports.find(name_);
+    if (it == ports.end() || it->second.empty()) {
+      return;
+    }
+
+    if (!BT::TreeNode::isBlackboardPointer(it->second)) {
+      value_ = BT::convertFromString<T>(it->second);
+      return;
+    }
+
+    const auto key = BT::TreeNode::stripBlackboardPointer(it->second);
+    // "{=}" refers to the entry with the name of the port
+    key_ = key == "=" ? name_ : std::string(key);
+  }
+
+  bool get(const BT::TreeNode & node, T & value) const
+  {
+    if (value_) {
+      value = *value_;
+      return true;
+    }
+
+    if (key_ && node.config().blackboard) {
+      const auto any = node.config().blackboard->getAnyLocked(*key_);
+      if (any && !any->empty()) {
+        if (auto result = any->tryCast<T>()) {
+          value = result.value();
+          return true;
+        }
+      }
+    }
+
+    // entries stored as strings are converted by getInput()
+    return static_cast<bool>(node.getInput<T>(name_, value));
+  }
+
+  bool is_static() const { return value_.has_value(); }
+
+private:
+  std::string name_;
+  std::optional<T> value_;
+  std::optional<std::string> key_;
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_CACHED_INPUT_PORT_HPP_
@@ -0,0 +1,113 @@
+#ifndef PANTHER_MANAGER_COROUTINE_HPP_
+#define PANTHER_MANAGER_COROUTINE_HPP_
+
+#include <string>
+
+#include <behaviortree_cpp/action_node.h>
+#include <behaviortree_cpp/basic_types.h>
+#include <behaviortree_cpp/tree_node.h>
+
+// stackless coroutines for C++17. A function body placed between PANTHER_CO_BEGIN and
+// PANTHER_CO_END returns at each yield or unmet await and continues from that point on the next
+// call, so asynchronous steps are written as straight-line code instead of a state machine.
+// Local variables don't survive a suspension, state has to be kept in members. Only one macro
+// suspending the coroutine can be used per line and no variable with an initializer can be in
+// scope of a suspension point.
+//
+//   void step() {
+//     PANTHER_CO_BEGIN(co_);
+//     start_request();
+//     PANTHER_CO_AWAIT(co_, request_done());
+//     PANTHER_CO_END(co_);
+//   }
+//
+// Trailing arguments of the macros are returned when the coroutine suspends or returns.
+
+#define PANTHER_CO_BEGIN(co)  \
+  switch ((co).resume_point) { \
+    case 0:
+
+// suspends until the next call
+#define PANTHER_CO_YIELD(co, ...)     \
+  do {                                \
+    (co).resume_point = __LINE__;     \
+    return __VA_ARGS__;               \
+    case __LINE__:;                   \
+  } while (0)
+
+// checks condition and suspends until a call in which it holds
+#define PANTHER_CO_AWAIT(co, condition, ...) \
+  do {                                       \
+    (co).resume_point = __LINE__;            \
+    [[fallthrough]];                         \
+    case __LINE__:                           \
+      if (!(condition)) {                    \
+        return __VA_ARGS__;                  \
+      }                                      \
+  } while (0)
+
+// finishes the coroutine, further calls don't execute its body until it is reset
+#define PANTHER_CO_RETURN(co, ...)                          \
+  do {                                                      \
+    (co).resume_point = panther_manager::Coroutine::done_; \
+    return __VA_ARGS__;                                     \
+  } while (0)
+
+#define PANTHER_CO_END(co) \
+  default:                 \
+    break;                 \
+    }                      \
+    (co).resume_point = panther_manager::Coroutine::done_
+
+namespace panther_manager
+{
+
+struct Coroutine
+{
+  static constexpr int done_ = -1;
+
+  int resume_point = 0;
+
+  bool is_done() const { return resume_point == done_; }
+  void reset() { resume_point = 0; }
+};
+
+// action node implemented as a coroutine. It is started when the node is ticked for the first time
+// and resumed with following ticks while it returns RUNNING, halting the node cancels it
+class CoroutineActionNode : public BT::StatefulActionNode
+{
+public:
+  CoroutineActionNode(const std::string & name, const BT::NodeConfig & conf)
+  : BT::StatefulActionNode(name, conf)
+  {
+  }
+
+protected:
+  // body of the coroutine, has to use the given coroutine state with PANTHER_CO_* macros
+  virtual BT::NodeStatus resume(Coroutine & co) = 0;
+
+  // called when the node is halted while the coroutine is suspended, should release resources
+  // used by pending operations
+  virtual void on_cancel() {}
+
+private:
+  Coroutine coroutine_;
+
+  BT::NodeStatus onStart() override final
+  {
+    coroutine_.reset();
+    return resume(coroutine_);
+  }
+
+  BT::NodeStatus onRunning() override final { return resume(coroutine_); }
+
+  void onHalted() override final
+  {
+    on_cancel();
+    coroutine_.reset();
+  }
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_COROUTINE_HPP_
@@ -9,6 +9,8 @@
 
 #include <ros/time.h>
 
+#include <panther_manager/plugins/cached_input_port.hpp>
+
 namespace panther_manager
 {
 class TickAfterTimeout : public BT::DecoratorNode
@@ -22,6 +24,7 @@ public:
   }
 
 private:
+  CachedInputPort<float> timeout_port_;
   ros::Duration timeout_;
   ros::Time last_success_time_;
 
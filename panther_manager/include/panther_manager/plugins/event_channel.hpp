@@ -0,0 +1,77 @@
+#ifndef PANTHER_MANAGER_EVENT_CHANNEL_HPP_
+#define PANTHER_MANAGER_EVENT_CHANNEL_HPP_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <panther_utils/mpmc_queue.hpp>
+
+namespace panther_manager
+{
+
+struct ShutdownEvent
+{
+  std::string reason;
+};
+
+using ManagerEvent = std::variant<ShutdownEvent>;
+
+// lock-free channel passing events from BT nodes to the manager. Any thread can push, events are
+// consumed by a single thread which waits for them on a file descriptor, so it doesn't poll the
+// channel
+class EventChannel
+{
+public:
+  // capacity has to be a power of two
+  explicit EventChannel(const std::size_t capacity = 64) : queue_(capacity)
+  {
+    event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0) {
+      throw std::runtime_error(std::string("Failed to create eventfd: ") + std::strerror(errno));
+    }
+  }
+
+  ~EventChannel() { close(event_fd_); }
+
+  EventChannel(const EventChannel &) = delete;
+  EventChannel & operator=(const EventChannel &) = delete;
+
+  // returns false if the channel is full and the event was dropped
+  bool push(const ManagerEvent & event)
+  {
+    if (!queue_.try_push(event)) {
+      return false;
+    }
+    const std::uint64_t one = 1;
+    [[maybe_unused]] const auto ret = write(event_fd_, &one, sizeof(one));
+    return true;
+  }
+
+  // returns false if the channel is empty
+  bool pop(ManagerEvent & event) { return queue_.try_pop(event); }
+
+  // becomes readable when events were pushed, has to be cleared with clear_notification()
+  int get_fd() const { return event_fd_; }
+
+  void clear_notification()
+  {
+    std::uint64_t count;
+    [[maybe_unused]] const auto ret = read(event_fd_, &count, sizeof(count));
+  }
+
+private:
+  panther_utils::MPMCQueue<ManagerEvent> queue_;
+  int event_fd_;
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_EVENT_CHANNEL_HPP_
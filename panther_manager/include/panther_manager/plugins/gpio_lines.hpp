@@ -0,0 +1,118 @@
+#ifndef PANTHER_MANAGER_GPIO_LINES_HPP_
+#define PANTHER_MANAGER_GPIO_LINES_HPP_
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <gpiod.hpp>
+
+#include <ros/ros.h>
+
+#include <std_msgs/Bool.h>
+
+namespace panther_manager
+{
+
+// output GPIO lines owned by the manager, so BT nodes drive them directly instead of calling
+// services of the power board node. The power board node has to be configured not to request the
+// same lines. State of each line is published as a latched std_msgs/Bool on
+// hardware/gpio/<line name in lowercase>, so the power board node can still report it
+class GPIOLines
+{
+public:
+  // requests all lines with value 0, throws std::runtime_error if any line can't be requested
+  GPIOLines(
+    const std::shared_ptr<ros::NodeHandle> & nh, const std::string & consumer,
+    const std::vector<std::string> & line_names)
+  {
+    const gpiod::chip chip("gpiochip0");
+    const gpiod::line_request lr = {consumer, gpiod::line_request::DIRECTION_OUTPUT, 0};
+
+    for (const auto & line_name : line_names) {
+      auto line = chip.find_line(line_name);
+      if (!line) {
+        throw std::runtime_error("Failed to find GPIO line: " + line_name);
+      }
+      // fails if the line is still requested by another process
+      try {
+        line.request(lr, 0);
+      } catch (const std::system_error & e) {
+        throw std::runtime_error("Failed to request GPIO line " + line_name + ": " + e.what());
+      }
+
+      auto & entry = lines_[line_name];
+      entry.line = line;
+      entry.state_pub =
+        nh->advertise<std_msgs::Bool>("hardware/gpio/" + to_lower(line_name), 1, true);
+      publish_state(entry, false);
+    }
+  }
+
+  ~GPIOLines()
+  {
+    for (auto & [name, entry] : lines_) {
+      entry.line.release();
+    }
+  }
+
+  GPIOLines(const GPIOLines &) = delete;
+  GPIOLines & operator=(const GPIOLines &) = delete;
+
+  bool has_line(const std::string & line_name) const
+  {
+    return lines_.find(line_name) != lines_.end();
+  }
+
+  // returns false if the value read back differs from the requested one, throws
+  // std::out_of_range if the line is not owned by the manager
+  bool set_value(const std::string & line_name, const bool value)
+  {
+    auto & entry = lines_.at(line_name);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entry.line.set_value(value);
+    const bool success = entry.line.get_value() == value;
+    if (success && value != entry.value) {
+      publish_state(entry, value);
+    }
+    return success;
+  }
+
+private:
+  struct Line
+  {
+    gpiod::line line;
+    ros::Publisher state_pub;
+    bool value = false;
+  };
+
+  std::mutex mutex_;
+  std::map<std::string, Line> lines_;
+
+  static void publish_state(Line & entry, const bool value)
+  {
+    entry.value = value;
+    std_msgs::Bool msg;
+    msg.data = value;
+    entry.state_pub.publish(msg);
+  }
+
+  static std::string to_lower(std::string str)
+  {
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) {
+      return std::tolower(c);
+    });
+    return str;
+  }
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_GPIO_LINES_HPP_
@@ -0,0 +1,228 @@
+#ifndef PANTHER_MANAGER_LED_ANIMATION_DISPATCHER_HPP_
+#define PANTHER_MANAGER_LED_ANIMATION_DISPATCHER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <ros/ros.h>
+
+#include <panther_msgs/SetLEDAnimation.h>
+
+#include <panther_utils/async_logger.hpp>
+#include <panther_utils/ring_buffer.hpp>
+#include <panther_utils/steady_clock.hpp>
+
+namespace panther_manager
+{
+
+enum class LEDAnimationRequestStatus {
+  PENDING = 0,
+  SUCCESS,
+  FAILURE,
+  // replaced by a later request before it was sent, so the animation was not shown
+  SUPERSEDED,
+  // result is no longer kept in the history
+  UNKNOWN,
+};
+
+// sends LED animation requests from a background thread. Requests queued until flush() are
+// batched and only the last one is sent, so ticking the tree never waits for the lights controller
+class LEDAnimationDispatcher
+{
+public:
+  LEDAnimationDispatcher(const std::shared_ptr<ros::NodeHandle> & nh, const std::string & srv_name)
+  : srv_name_(srv_name), results_(results_history_len_), nh_(nh)
+  {
+    thread_ = std::thread(&LEDAnimationDispatcher::run, this);
+  }
+
+  ~LEDAnimationDispatcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+      // don't wait for a hung call when shutting down
+      srv_client_.shutdown();
+    }
+    cv_.notify_one();
+    thread_.join();
+  }
+
+  LEDAnimationDispatcher(const LEDAnimationDispatcher &) = delete;
+  LEDAnimationDispatcher & operator=(const LEDAnimationDispatcher &) = delete;
+
+  // returns ticket used to check status of the request. If retry is set, a failed request is sent
+  // again until it succeeds, a later request is sent or max_attempts_ is reached
+  std::uint64_t queue(const panther_msgs::SetLEDAnimation::Request & request, const bool retry)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_) {
+      results_.push(std::make_pair(pending_->ticket, LEDAnimationRequestStatus::SUPERSEDED));
+    }
+    pending_ = QueuedRequest{++last_ticket_, request, retry, 0};
+    return last_ticket_;
+  }
+
+  // passes the last queued request to the background thread
+  void flush()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      abort_timed_out_call();
+      if (!pending_) {
+        return;
+      }
+      if (to_send_) {
+        results_.push(std::make_pair(to_send_->ticket, LEDAnimationRequestStatus::SUPERSEDED));
+      }
+      to_send_ = std::move(pending_);
+      pending_.reset();
+    }
+    cv_.notify_one();
+  }
+
+  LEDAnimationRequestStatus get_status(const std::uint64_t ticket) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if ((pending_ && pending_->ticket == ticket) || (to_send_ && to_send_->ticket == ticket)) {
+      return LEDAnimationRequestStatus::PENDING;
+    }
+    if (ticket == in_flight_ticket_) {
+      return call_timed_out() ? LEDAnimationRequestStatus::FAILURE
+                              : LEDAnimationRequestStatus::PENDING;
+    }
+    // the latest result of a retried request is the valid one
+    for (std::size_t i = results_.size(); i-- > 0;) {
+      if (results_[i].first == ticket) {
+        return results_[i].second;
+      }
+    }
+    return LEDAnimationRequestStatus::UNKNOWN;
+  }
+
+private:
+  struct QueuedRequest
+  {
+    std::uint64_t ticket;
+    panther_msgs::SetLEDAnimation::Request request;
+    bool retry;
+    unsigned attempts;
+  };
+
+  static constexpr std::size_t results_history_len_ = 16;
+  static constexpr unsigned max_attempts_ = 10;
+  static constexpr std::chrono::milliseconds retry_period_{1000};
+  // roscpp service calls have no timeout, calls taking longer are aborted
+  static constexpr std::chrono::milliseconds call_timeout_{1000};
+
+  bool running_ = true;
+  bool call_aborted_ = false;
+  std::uint64_t last_ticket_ = 0;
+  // 0 if no call is in progress
+  std::uint64_t in_flight_ticket_ = 0;
+  std::string srv_name_;
+  panther_utils::SteadyClock::time_point call_start_;
+  std::optional<QueuedRequest> pending_;
+  std::optional<QueuedRequest> to_send_;
+  panther_utils::RingBuffer<std::pair<std::uint64_t, LEDAnimationRequestStatus>> results_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread thread_;
+  std::shared_ptr<ros::NodeHandle> nh_;
+  ros::ServiceClient srv_client_;
+  panther_utils::AsyncLogger & logger_ = panther_utils::AsyncLogger::instance();
+
+  void run()
+  {
+    std::optional<QueuedRequest> retry;
+    while (true) {
+      QueuedRequest request;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const auto ready = [this] { return !running_ || to_send_; };
+        if (retry) {
+          cv_.wait_for(lock, retry_period_, ready);
+        } else {
+          cv_.wait(lock, ready);
+        }
+        if (!running_) {
+          return;
+        }
+
+        // a later request replaces the failed one
+        if (to_send_) {
+          request = std::move(*to_send_);
+          to_send_.reset();
+        } else {
+          request = std::move(*retry);
+        }
+        retry.reset();
+
+        // client is replaced only under the lock, as flush() can shut it down
+        if (!srv_client_.isValid()) {
+          srv_client_ = nh_->serviceClient<panther_msgs::SetLEDAnimation>(srv_name_, true);
+        }
+        in_flight_ticket_ = request.ticket;
+        call_start_ = panther_utils::SteadyClock::now();
+        call_aborted_ = false;
+      }
+
+      const auto status = call(request.request);
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      in_flight_ticket_ = 0;
+      results_.push(std::make_pair(request.ticket, status));
+      if (
+        status == LEDAnimationRequestStatus::FAILURE && request.retry &&
+        ++request.attempts < max_attempts_) {
+        retry = std::move(request);
+      }
+    }
+  }
+
+  LEDAnimationRequestStatus call(const panther_msgs::SetLEDAnimation::Request & request)
+  {
+    panther_msgs::SetLEDAnimation srv;
+    srv.request = request;
+    if (!srv_client_.call(srv)) {
+      logger_.error("Failed to call %s service", srv_name_);
+      return LEDAnimationRequestStatus::FAILURE;
+    }
+    if (!srv.response.success) {
+      logger_.error(
+        "Failed to call %s service, message: %s", srv_name_, srv.response.message);
+      return LEDAnimationRequestStatus::FAILURE;
+    }
+    return LEDAnimationRequestStatus::SUCCESS;
+  }
+
+  // called with mutex_ locked
+  bool call_timed_out() const
+  {
+    return in_flight_ticket_ != 0 &&
+           panther_utils::SteadyClock::now() - call_start_ > call_timeout_;
+  }
+
+  // called with mutex_ locked. Dropping the connection of the persistent client makes the blocked
+  // call return with an error
+  void abort_timed_out_call()
+  {
+    if (call_timed_out() && !call_aborted_) {
+      logger_.warn("Call to %s service timed out", srv_name_);
+      srv_client_.shutdown();
+      call_aborted_ = true;
+    }
+  }
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_LED_ANIMATION_DISPATCHER_HPP_
@@ -0,0 +1,169 @@
+#ifndef PANTHER_MANAGER_REACTOR_HPP_
+#define PANTHER_MANAGER_REACTOR_HPP_
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace panther_manager
+{
+
+// single thread waiting on epoll for readiness of file descriptors used by BT nodes, so I/O
+// progresses independently of tick frequency and ticks never block on a socket. Callbacks are
+// called from the reactor thread and should only do non-blocking I/O and store results for the
+// next tick
+class Reactor
+{
+public:
+  using Callback = std::function<void(std::uint32_t events)>;
+
+  Reactor()
+  {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+      throw std::runtime_error(std::string("Failed to create epoll: ") + std::strerror(errno));
+    }
+
+    stop_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (stop_fd_ < 0) {
+      const int error = errno;
+      close(epoll_fd_);
+      throw std::runtime_error(std::string("Failed to create eventfd: ") + std::strerror(error));
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = stop_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, stop_fd_, &event);
+
+    thread_ = std::thread(&Reactor::run, this);
+  }
+
+  ~Reactor()
+  {
+    const std::uint64_t one = 1;
+    [[maybe_unused]] const auto ret = write(stop_fd_, &one, sizeof(one));
+    thread_.join();
+    close(stop_fd_);
+    close(epoll_fd_);
+  }
+
+  Reactor(const Reactor &) = delete;
+  Reactor & operator=(const Reactor &) = delete;
+
+  // callback is called with epoll events each time file descriptor becomes ready, throws
+  // std::runtime_error if it can't be registered
+  void add(const int fd, const std::uint32_t events, Callback callback)
+  {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+      throw std::runtime_error(
+        std::string("Failed to register file descriptor: ") + std::strerror(errno));
+    }
+    callbacks_[fd] = std::move(callback);
+  }
+
+  // once it returns, callback of the file descriptor is not running and won't be called again.
+  // Can be called from a callback
+  void remove(const int fd)
+  {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    callbacks_.erase(fd);
+  }
+
+  // creates one-shot timer calling callback once timeout in seconds elapses, returns its file
+  // descriptor which has to be released with remove_timer()
+  int add_timer(const double timeout, Callback callback)
+  {
+    const int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) {
+      throw std::runtime_error(std::string("Failed to create timer: ") + std::strerror(errno));
+    }
+
+    itimerspec spec = {};
+    spec.it_value.tv_sec = static_cast<time_t>(timeout);
+    spec.it_value.tv_nsec = static_cast<long>((timeout - std::floor(timeout)) * 1e9);
+    // zero value disarms timer
+    if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+      spec.it_value.tv_nsec = 1;
+    }
+    timerfd_settime(fd, 0, &spec, nullptr);
+
+    try {
+      add(fd, EPOLLIN, [fd, callback = std::move(callback)](std::uint32_t events) {
+        // expiration has to be read, otherwise timer stays ready
+        std::uint64_t expirations;
+        if (read(fd, &expirations, sizeof(expirations)) > 0) {
+          callback(events);
+        }
+      });
+    } catch (const std::runtime_error &) {
+      close(fd);
+      throw;
+    }
+    return fd;
+  }
+
+  void remove_timer(const int fd)
+  {
+    remove(fd);
+    close(fd);
+  }
+
+private:
+  static constexpr int max_events_ = 16;
+
+  int epoll_fd_;
+  int stop_fd_;
+  std::recursive_mutex mutex_;
+  std::unordered_map<int, Callback> callbacks_;
+  std::thread thread_;
+
+  void run()
+  {
+    epoll_event events[max_events_];
+    while (true) {
+      const int count = epoll_wait(epoll_fd_, events, max_events_, -1);
+      if (count < 0 && errno != EINTR) {
+        return;
+      }
+
+      for (int i = 0; i < count; i++) {
+        const int fd = events[i].data.fd;
+        if (fd == stop_fd_) {
+          return;
+        }
+
+        // callback could be removed by a callback called earlier in this iteration
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        const auto it = callbacks_.find(fd);
+        if (it != callbacks_.end()) {
+          // copy, so callback can remove itself
+          const auto callback = it->second;
+          callback(events[i].events);
+        }
+      }
+    }
+  }
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_REACTOR_HPP_
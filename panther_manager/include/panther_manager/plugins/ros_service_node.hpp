@@ -12,6 +12,11 @@
 #include <ros/ros.h>
 #include <ros/service_client.h>
 
+#include <panther_utils/async_logger.hpp>
+#include <panther_utils/tracepoints.hpp>
+
+#include <panther_manager/plugins/cached_input_port.hpp>
+
 namespace panther_manager
 {
 
@@ -20,9 +25,17 @@ class RosServiceNode : public BT::SyncActionNode
 {
 public:
   explicit RosServiceNode(const std::string & name, const BT::NodeConfig & conf, const std::shared_ptr<ros::NodeHandle> & nh)
-  : BT::SyncActionNode(name, conf), nh_(nh)
+  : BT::SyncActionNode(name, conf),
+    service_name_port_(*this, "service_name"),
+    timeout_port_(*this, "timeout"),
+    nh_(nh)
   {
     node_name_ = ros::this_node::getName();
+
+    unsigned srv_timeout_ms;
+    if (timeout_port_.is_static() && timeout_port_.get(*this, srv_timeout_ms)) {
+      srv_timeout_ = ros::Duration(static_cast<double>(srv_timeout_ms) * 1e-3);
+    }
   }
 
   virtual ~RosServiceNode() = default;
@@ -46,42 +59,55 @@ public:
   virtual BT::NodeStatus on_response(const ResponseType & response) = 0;
 
   std::string get_node_name() const { return node_name_; }
-  std::string get_srv_name() const { return srv_name_; }
+  const std::string & get_srv_name() const { return srv_name_; }
+  panther_utils::AsyncLogger & get_logger() const { return logger_; }
 
 private:
   std::string node_name_;
   std::string srv_name_;
+  CachedInputPort<std::string> service_name_port_;
+  CachedInputPort<unsigned> timeout_port_;
 
   ros::Duration srv_timeout_;
   ros::ServiceClient srv_client_;
   std::shared_ptr<ros::NodeHandle> nh_;
+  panther_utils::AsyncLogger & logger_ = panther_utils::AsyncLogger::instance();
 
   BT::NodeStatus tick() override
   {
-    if (!getInput<std::string>("service_name", srv_name_) || srv_name_ == "") {
-      throw BT::RuntimeError("[", name(), "] Failed to get input [service_name]");
-    }
-
-    unsigned srv_timeout_ms;
-    if (!getInput<unsigned>("timeout", srv_timeout_ms)) {
-      throw BT::RuntimeError("[", name(), "] Failed to get input [timeout]");
+    // static service name is read only once, when creating client
+    if (!srv_client_.isValid() || !service_name_port_.is_static()) {
+      std::string srv_name;
+      if (!service_name_port_.get(*this, srv_name) || srv_name == "") {
+        throw BT::RuntimeError("[", name(), "] Failed to get input [service_name]");
+      }
+      if (!srv_client_.isValid() || srv_name != srv_name_) {
+        srv_name_ = srv_name;
+        srv_client_ = nh_->serviceClient<ServiceT>(srv_name_);
+      }
     }
-    srv_timeout_ = ros::Duration(static_cast<double>(srv_timeout_ms) * 1e-3);
 
-    if (!srv_client_.isValid()) {
-      srv_client_ = nh_->serviceClient<ServiceT>(srv_name_);
+    if (!timeout_port_.is_static()) {
+      unsigned srv_timeout_ms;
+      if (!timeout_port_.get(*this, srv_timeout_ms)) {
+        throw BT::RuntimeError("[", name(), "] Failed to get input [timeout]");
+      }
+      srv_timeout_ = ros::Duration(static_cast<double>(srv_timeout_ms) * 1e-3);
     }
 
     if (!srv_client_.waitForExistence(srv_timeout_)) {
-      ROS_ERROR("[%s] Timeout waiting for service %s", node_name_.c_str(), srv_name_.c_str());
+      logger_.error("Timeout waiting for service %s", srv_name_);
       return BT::NodeStatus::FAILURE;
     }
 
     RequestType request;
     ResponseType response;
     update_request(request);
-    if (!srv_client_.call(request, response)) {
-      ROS_ERROR("[%s] Failed to call service %s", node_name_.c_str(), srv_name_.c_str());
+    PANTHER_TRACEPOINT(service_call_begin, srv_name_.c_str());
+    const bool called = srv_client_.call(request, response);
+    PANTHER_TRACEPOINT(service_call_end, srv_name_.c_str(), called);
+    if (!called) {
+      logger_.error("Failed to call service %s", srv_name_);
       return BT::NodeStatus::FAILURE;
     }
     return on_response(response);
@@ -1,17 +1,30 @@
 #ifndef PANTHER_MANAGER_SHUTDOWN_HOST_HPP_
 #define PANTHER_MANAGER_SHUTDOWN_HOST_HPP_
 
-#include <cstdlib>
+#include <csignal>
 #include <functional>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <libssh/libssh.h>
 
 #include <ros/time.h>
 
+#include <panther_utils/tracepoints.hpp>
+
+#include <panther_manager/plugins/async_ping.hpp>
+#include <panther_manager/plugins/coroutine.hpp>
+#include <panther_manager/plugins/reactor.hpp>
+#include <panther_manager/plugins/ssh_key_store.hpp>
+
 namespace panther_manager
 {
 
@@ -36,13 +49,15 @@ public:
     command_(""),
     timeout_(5.0),
     ping_for_success_(true),
-    hash_(std::hash<std::string>{}(""))
+    hash_(std::hash<std::string>{}("")),
+    search_default_keys_(true)
   {
   }
   ShutdownHost(
     const std::string ip, const std::string user, const int port = 22,
     const std::string command = "sudo shutdown now", const float timeout = 5.0,
-    const bool ping_for_success = true)
+    const bool ping_for_success = true, const std::vector<SSHKey> & keys = {},
+    const bool search_default_keys = true)
   : ip_(ip),
     user_(user),
     port_(port),
@@ -50,92 +65,86 @@ public:
     timeout_(timeout),
     ping_for_success_(ping_for_success),
     hash_(std::hash<std::string>{}(ip + user + std::to_string(port))),
+    keys_(keys),
+    search_default_keys_(search_default_keys),
     state_(ShutdownHostState::IDLE)
   {
   }
 
-  ~ShutdownHost() {}
+  ~ShutdownHost()
+  {
+    if (ping_pid_ > 0) {
+      kill(ping_pid_, SIGKILL);
+      waitpid(ping_pid_, nullptr, 0);
+    }
+  }
 
+  // advances shutdown of the host without blocking, has to be called until the host reaches
+  // SKIPPED, SUCCESS or FAILURE state
   void call()
   {
-    switch (state_) {
-      case ShutdownHostState::IDLE:
-        if (!is_available()) {
-          state_ = ShutdownHostState::SKIPPED;
-          break;
-        }
+    const auto previous_state = state_;
+    step();
 
-        try {
-          request_shutdown();
-        } catch (std::runtime_error err) {
-          state_ = ShutdownHostState::FAILURE;
-          failure_reason_ = err.what();
-          break;
-        }
-        state_ = ShutdownHostState::COMMAND_EXECUTED;
-        break;
-
-      case ShutdownHostState::COMMAND_EXECUTED:
-        try {
-          if (update_response()) {
-            break;
-          }
-        } catch (std::runtime_error err) {
-          state_ = ShutdownHostState::FAILURE;
-          failure_reason_ = err.what();
-          break;
-        }
-        state_ = ShutdownHostState::RESPONSE_RECEIVED;
-        break;
-
-      case ShutdownHostState::RESPONSE_RECEIVED:
-        state_ = ShutdownHostState::PINGING;
-        break;
-      case ShutdownHostState::PINGING:
-        if (ping_for_success_ ? !is_available() : true) {
-          state_ = ShutdownHostState::SUCCESS;
-          break;
-        }
-        if (timeout_exceeded()) {
-          state_ = ShutdownHostState::FAILURE;
-          failure_reason_ = "Timeout exceeded";
-        }
-        break;
-
-      default:
-        break;
+    if (state_ != previous_state) {
+      PANTHER_TRACEPOINT(
+        shutdown_host_state, ip_.c_str(), static_cast<int>(previous_state),
+        static_cast<int>(state_));
     }
   }
 
-  bool is_available() const
+  // pings are sent over ICMP socket handled by the reactor, if it isn't permitted ping command is
+  // used instead
+  void set_reactor(const std::shared_ptr<Reactor> & reactor)
   {
-    return system(("ping -c 1 -w 1 " + ip_ + " > /dev/null").c_str()) == 0;
+    async_ping_ = std::make_shared<AsyncPing>(reactor);
   }
 
-  void close_connection()
+  // stops pending ping and closes connection, the next call starts over
+  void cancel()
   {
-    if (ssh_channel_is_closed(channel_)) {
-      return;
+    if (async_ping_) {
+      async_ping_->cancel();
     }
+    async_ping_pending_ = false;
+    if (ping_pid_ > 0) {
+      kill(ping_pid_, SIGKILL);
+      waitpid(ping_pid_, nullptr, 0);
+      ping_pid_ = -1;
+    }
+    close_connection();
+    coroutine_.reset();
+    state_ = ShutdownHostState::IDLE;
+  }
 
-    ssh_channel_send_eof(channel_);
-    ssh_channel_close(channel_);
-    ssh_channel_free(channel_);
-    ssh_disconnect(session_);
-    ssh_free(session_);
+  void close_connection()
+  {
+    if (channel_) {
+      if (ssh_channel_is_open(channel_)) {
+        ssh_channel_send_eof(channel_);
+        ssh_channel_close(channel_);
+      }
+      ssh_channel_free(channel_);
+      channel_ = nullptr;
+    }
+    if (session_) {
+      ssh_disconnect(session_);
+      ssh_free(session_);
+      session_ = nullptr;
+    }
   }
 
   int get_port() const { return port_; }
 
-  std::string get_ip() const { return ip_; }
+  const std::string & get_ip() const { return ip_; }
 
   std::string get_user() const { return user_; }
 
   std::string get_command() const { return command_; }
 
-  std::string get_error() const { return failure_reason_; }
+  const std::string & get_error() const { return failure_reason_; }
 
-  std::string get_response() const { return output_; }
+  const std::string & get_response() const { return output_; }
 
   ShutdownHostState get_state() const { return state_; }
 
@@ -153,6 +162,9 @@ private:
   const int port_;
   const bool ping_for_success_;
   const float timeout_;
+  // preloaded keys, if none is accepted and search_default_keys_ is set, keys from ~/.ssh are tried
+  const std::vector<SSHKey> keys_;
+  const bool search_default_keys_;
 
   char buffer_[1024];
   const int verbosity_ = SSH_LOG_NOLOG;
@@ -160,20 +172,186 @@ private:
   std::string output_;
   std::string failure_reason_;
   ros::Time command_time_;
+  ros::Time connect_time_;
   ShutdownHostState state_;
+  static constexpr double ping_timeout_ = 1.0;
+  static constexpr double connect_timeout_ = 10.0;
+  Coroutine coroutine_;
+  pid_t ping_pid_ = -1;
+  bool host_available_ = false;
+  bool async_ping_pending_ = false;
+  std::shared_ptr<AsyncPing> async_ping_;
+
+  ssh_session session_ = nullptr;
+  ssh_channel channel_ = nullptr;
+  int ssh_status_ = SSH_OK;
+  std::size_t key_index_ = 0;
+  bool authenticated_ = false;
+
+  void step()
+  {
+    PANTHER_CO_BEGIN(coroutine_);
 
-  ssh_session session_;
-  ssh_channel channel_;
+    PANTHER_CO_AWAIT(coroutine_, ping());
+    if (!host_available_) {
+      state_ = ShutdownHostState::SKIPPED;
+      PANTHER_CO_RETURN(coroutine_);
+    }
 
-  void request_shutdown()
-  {
-    ssh_execute_command(command_);
+    // libssh runs in non-blocking mode, each call is repeated with following ticks until it
+    // finishes, so an unresponsive host doesn't block the tree
+    if (!open_session()) {
+      fail("Failed to open session");
+      PANTHER_CO_RETURN(coroutine_);
+    }
+
+    PANTHER_CO_AWAIT(coroutine_, ssh_finished(ssh_connect(session_), SSH_AGAIN));
+    if (ssh_status_ != SSH_OK) {
+      fail_ssh("Error connecting to host: ");
+      PANTHER_CO_RETURN(coroutine_);
+    }
+
+    authenticated_ = false;
+    for (key_index_ = 0; key_index_ < keys_.size() && !authenticated_; key_index_++) {
+      if (!keys_[key_index_] || connect_timeout_exceeded()) {
+        continue;
+      }
+      PANTHER_CO_AWAIT(coroutine_, authenticate_with_key());
+      authenticated_ = ssh_status_ == SSH_AUTH_SUCCESS;
+    }
+    // trying preloaded default keys again would only count towards server's MaxAuthTries
+    if (!authenticated_ && search_default_keys_ && !connect_timeout_exceeded()) {
+      PANTHER_CO_AWAIT(coroutine_, authenticate_with_default_keys());
+      authenticated_ = ssh_status_ == SSH_AUTH_SUCCESS;
+    }
+    if (!authenticated_) {
+      fail_ssh("Error authenticating with public key: ");
+      PANTHER_CO_RETURN(coroutine_);
+    }
+
+    channel_ = ssh_channel_new(session_);
+    if (channel_ == NULL) {
+      fail_ssh("Failed to create ssh channel: ");
+      PANTHER_CO_RETURN(coroutine_);
+    }
+
+    PANTHER_CO_AWAIT(coroutine_, ssh_finished(ssh_channel_open_session(channel_), SSH_AGAIN));
+    if (ssh_status_ != SSH_OK) {
+      fail_ssh("Failed to open ssh channel: ");
+      PANTHER_CO_RETURN(coroutine_);
+    }
+
+    PANTHER_CO_AWAIT(coroutine_, execute_command());
+    if (ssh_status_ != SSH_OK) {
+      fail_ssh("Failed to execute ssh command: ");
+      PANTHER_CO_RETURN(coroutine_);
+    }
     command_time_ = ros::Time::now();
+    state_ = ShutdownHostState::COMMAND_EXECUTED;
+
+    // read command output until the channel reaches EOF
+    while (true) {
+      PANTHER_CO_YIELD(coroutine_);
+      PANTHER_CO_AWAIT(coroutine_, ping());
+      try {
+        if (!update_response()) {
+          break;
+        }
+      } catch (const std::runtime_error & err) {
+        fail(err.what());
+        PANTHER_CO_RETURN(coroutine_);
+      }
+    }
+    state_ = ShutdownHostState::RESPONSE_RECEIVED;
+    PANTHER_CO_YIELD(coroutine_);
+
+    state_ = ShutdownHostState::PINGING;
+    PANTHER_CO_YIELD(coroutine_);
+
+    // host is shut down once it stops responding to ping
+    while (ping_for_success_) {
+      PANTHER_CO_AWAIT(coroutine_, ping());
+      if (!host_available_) {
+        break;
+      }
+      if (timeout_exceeded()) {
+        fail("Timeout exceeded");
+        PANTHER_CO_RETURN(coroutine_);
+      }
+      PANTHER_CO_YIELD(coroutine_);
+    }
+    state_ = ShutdownHostState::SUCCESS;
+
+    PANTHER_CO_END(coroutine_);
+  }
+
+  // starts ping if none is pending and returns true once it finished, result is stored in
+  // host_available_
+  bool ping()
+  {
+    if (async_ping_) {
+      if (!async_ping_pending_) {
+        async_ping_pending_ = async_ping_->start(ip_, ping_timeout_);
+        if (!async_ping_pending_) {
+          // fall back to ping command for this host
+          async_ping_.reset();
+          return ping_process();
+        }
+      }
+
+      const auto result = async_ping_->get_result();
+      if (result == PingResult::PENDING) {
+        return false;
+      }
+      host_available_ = result == PingResult::REACHABLE;
+      async_ping_pending_ = false;
+      return true;
+    }
+    return ping_process();
+  }
+
+  // starts ping command in a child process if none is running and returns true once it exited
+  bool ping_process()
+  {
+    if (ping_pid_ <= 0) {
+      std::vector<char *> argv = {
+        const_cast<char *>("ping"), const_cast<char *>("-c"), const_cast<char *>("1"),
+        const_cast<char *>("-w"), const_cast<char *>("1"), const_cast<char *>(ip_.c_str()),
+        nullptr};
+
+      posix_spawn_file_actions_t actions;
+      posix_spawn_file_actions_init(&actions);
+      posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+      posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+      const int ret = posix_spawnp(&ping_pid_, "ping", &actions, nullptr, argv.data(), environ);
+      posix_spawn_file_actions_destroy(&actions);
+
+      if (ret != 0) {
+        ping_pid_ = -1;
+        host_available_ = false;
+        return true;
+      }
+    }
+
+    int status;
+    const pid_t pid = waitpid(ping_pid_, &status, WNOHANG);
+    if (pid == 0) {
+      return false;
+    }
+    host_available_ = pid == ping_pid_ && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    ping_pid_ = -1;
+    return true;
+  }
+
+  void fail(const std::string & reason)
+  {
+    state_ = ShutdownHostState::FAILURE;
+    failure_reason_ = reason;
   }
 
   bool update_response()
   {
-    if (!is_available()) {
+    if (!host_available_) {
       close_connection();
       throw std::runtime_error("Lost connection");
     }
@@ -197,58 +375,61 @@ private:
 
   bool timeout_exceeded()
   {
-    return (ros::Time::now() - command_time_) > ros::Duration(timeout_) && is_available();
+    return (ros::Time::now() - command_time_) > ros::Duration(timeout_) && host_available_;
   }
 
-  void ssh_execute_command(const std::string & command)
+  // creates session in non-blocking mode, connection is started by ssh_connect()
+  bool open_session()
   {
     session_ = ssh_new();
     if (session_ == NULL) {
-      throw std::runtime_error("Failed to open session");
-    };
+      return false;
+    }
 
     ssh_options_set(session_, SSH_OPTIONS_HOST, ip_.c_str());
     ssh_options_set(session_, SSH_OPTIONS_USER, user_.c_str());
     ssh_options_set(session_, SSH_OPTIONS_PORT, &port_);
     ssh_options_set(session_, SSH_OPTIONS_LOG_VERBOSITY, &verbosity_);
+    ssh_set_blocking(session_, 0);
+    connect_time_ = ros::Time::now();
+    return true;
+  }
 
-    if (ssh_connect(session_) != SSH_OK) {
-      std::string err = ssh_get_error(session_);
-      ssh_free(session_);
-      throw std::runtime_error("Error connecting to host: " + err);
-    }
+  // stores status of a non-blocking libssh call, returns true once the call finished or connecting
+  // timed out
+  bool ssh_finished(const int status, const int again)
+  {
+    ssh_status_ = status;
+    return status != again || connect_timeout_exceeded();
+  }
 
-    if (ssh_userauth_publickey_auto(session_, NULL, NULL) != SSH_AUTH_SUCCESS) {
-      std::string err = ssh_get_error(session_);
-      ssh_disconnect(session_);
-      ssh_free(session_);
-      throw std::runtime_error("Error authenticating with public key: " + err);
-    }
+  bool authenticate_with_key()
+  {
+    return ssh_finished(
+      ssh_userauth_publickey(session_, NULL, keys_[key_index_].get()), SSH_AUTH_AGAIN);
+  }
 
-    channel_ = ssh_channel_new(session_);
-    if (channel_ == NULL) {
-      std::string err = ssh_get_error(session_);
-      ssh_disconnect(session_);
-      ssh_free(session_);
-      throw std::runtime_error("Failed to create ssh channel: " + err);
-    }
+  bool authenticate_with_default_keys()
+  {
+    return ssh_finished(ssh_userauth_publickey_auto(session_, NULL, NULL), SSH_AUTH_AGAIN);
+  }
 
-    if (ssh_channel_open_session(channel_) != SSH_OK) {
-      std::string err = ssh_get_error(session_);
-      ssh_channel_free(channel_);
-      ssh_disconnect(session_);
-      ssh_free(session_);
-      throw std::runtime_error("Failed to open ssh channel: " + err);
-    }
+  bool execute_command()
+  {
+    return ssh_finished(ssh_channel_request_exec(channel_, command_.c_str()), SSH_AGAIN);
+  }
 
-    if (ssh_channel_request_exec(channel_, command.c_str()) != SSH_OK) {
-      std::string err = ssh_get_error(session_);
-      ssh_channel_close(channel_);
-      ssh_channel_free(channel_);
-      ssh_disconnect(session_);
-      ssh_free(session_);
-      throw std::runtime_error("Failed to execute ssh command: " + err);
-    }
+  bool connect_timeout_exceeded() const
+  {
+    return (ros::Time::now() - connect_time_) > ros::Duration(connect_timeout_);
+  }
+
+  void fail_ssh(const std::string & reason)
+  {
+    const std::string err =
+      connect_timeout_exceeded() ? "Timeout exceeded" : ssh_get_error(session_);
+    close_connection();
+    fail(reason + err);
   }
 };
 
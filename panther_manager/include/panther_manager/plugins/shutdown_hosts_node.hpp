@@ -16,18 +16,27 @@
 
 #include <ros/ros.h>
 
+#include <panther_utils/async_logger.hpp>
+
+#include <panther_manager/plugins/coroutine.hpp>
+#include <panther_manager/plugins/reactor.hpp>
 #include <panther_manager/plugins/shutdown_host.hpp>
+#include <panther_manager/plugins/ssh_key_store.hpp>
 
 namespace panther_manager
 {
 
-class ShutdownHosts : public BT::StatefulActionNode
+class ShutdownHosts : public CoroutineActionNode
 {
 public:
   explicit ShutdownHosts(const std::string & name, const BT::NodeConfig & conf)
-  : BT::StatefulActionNode(name, conf)
+  : CoroutineActionNode(name, conf)
   {
     node_name_ = ros::this_node::getName();
+    if (config().blackboard) {
+      config().blackboard->get("ssh_key_store", ssh_key_store_);
+      config().blackboard->get("reactor", reactor_);
+    }
   }
 
   virtual ~ShutdownHosts() = default;
@@ -48,6 +57,31 @@ public:
   std::string get_node_name() const { return node_name_; }
   std::vector<std::size_t> const get_failed_hosts() { return failed_hosts_; }
 
+  // keys preloaded at startup, loads key if it wasn't preloaded. Returns no keys if key store is
+  // not available on blackboard, so hosts fall back to keys from ~/.ssh
+  // key of the host is tried before default keys
+  std::vector<SSHKey> get_ssh_keys(const std::string & key_path = "") const
+  {
+    if (!ssh_key_store_) {
+      return {};
+    }
+    auto keys = ssh_key_store_->get_default_keys();
+    if (!key_path.empty()) {
+      keys.insert(keys.begin(), ssh_key_store_->load(key_path));
+    }
+    return keys;
+  }
+
+  // false if default keys are already returned by get_ssh_keys()
+  bool search_default_keys() const
+  {
+    return !ssh_key_store_ || !ssh_key_store_->default_keys_loaded();
+  }
+
+protected:
+  std::shared_ptr<SSHKeyStore> ssh_key_store_;
+  std::shared_ptr<Reactor> reactor_;
+
 private:
   int check_host_index_ = 0;
   std::string node_name_;
@@ -56,26 +90,44 @@ private:
   std::vector<std::size_t> skipped_hosts_;
   std::vector<std::size_t> succeeded_hosts_;
   std::vector<std::size_t> failed_hosts_;
+  panther_utils::AsyncLogger & logger_ = panther_utils::AsyncLogger::instance();
 
-  BT::NodeStatus onStart()
+  BT::NodeStatus resume(Coroutine & co) override
   {
+    PANTHER_CO_BEGIN(co);
+
+    hosts_.clear();
     update_hosts(hosts_);
     remove_duplicate_hosts(hosts_);
     if (hosts_.size() <= 0) {
       ROS_ERROR("[%s] Hosts list is empty! Check configuration!", node_name_.c_str());
-      return BT::NodeStatus::FAILURE;
+      PANTHER_CO_RETURN(co, BT::NodeStatus::FAILURE);
+    }
+    if (reactor_) {
+      for (auto & host : hosts_) {
+        host->set_reactor(reactor_);
+      }
     }
     hosts_to_check_.resize(hosts_.size());
     std::iota(hosts_to_check_.begin(), hosts_to_check_.end(), 0);
-    return BT::NodeStatus::RUNNING;
+    check_host_index_ = 0;
+    skipped_hosts_.clear();
+    succeeded_hosts_.clear();
+    failed_hosts_.clear();
+
+    // hosts are shut down concurrently, each tick advances one of them
+    while (hosts_to_check_.size() > 0) {
+      PANTHER_CO_YIELD(co, BT::NodeStatus::RUNNING);
+      call_next_host();
+    }
+
+    PANTHER_CO_RETURN(co, post_process());
+    PANTHER_CO_END(co);
+    return BT::NodeStatus::FAILURE;
   }
 
-  BT::NodeStatus onRunning()
+  void call_next_host()
   {
-    if (hosts_to_check_.size() <= 0) {
-      return post_process();
-    }
-
     if (check_host_index_ >= hosts_to_check_.size()) {
       check_host_index_ = 0;
     }
@@ -86,6 +138,7 @@ private:
 
     switch (host->get_state()) {
       case ShutdownHostState::RESPONSE_RECEIVED:
+        // command output doesn't fit in a record of the async logger, logged once per host
         ROS_INFO(
           "[%s] Device at: %s response:\n%s", node_name_.c_str(), host->get_ip().c_str(),
           host->get_response().c_str());
@@ -93,23 +146,20 @@ private:
         break;
 
       case ShutdownHostState::SUCCESS:
-        ROS_INFO(
-          "[%s] Successfuly shutdown device at: %s", node_name_.c_str(), host->get_ip().c_str());
+        logger_.info("Successfuly shutdown device at: %s", host->get_ip());
         succeeded_hosts_.push_back(host_index);
         hosts_to_check_.erase(hosts_to_check_.begin() + check_host_index_);
         break;
 
       case ShutdownHostState::FAILURE:
-        ROS_WARN(
-          "[%s] Failed to shutdown device at: %s. Error: %s", node_name_.c_str(), host->get_ip().c_str(),
-          host->get_error().c_str());
+        logger_.warn(
+          "Failed to shutdown device at: %s. Error: %s", host->get_ip(), host->get_error());
         failed_hosts_.push_back(host_index);
         hosts_to_check_.erase(hosts_to_check_.begin() + check_host_index_);
         break;
 
       case ShutdownHostState::SKIPPED:
-        ROS_WARN(
-          "[%s] Davice at: %s not available, skipping", node_name_.c_str(), host->get_ip().c_str());
+        logger_.warn("Davice at: %s not available, skipping", host->get_ip());
         skipped_hosts_.push_back(host_index);
         hosts_to_check_.erase(hosts_to_check_.begin() + check_host_index_);
         break;
@@ -118,8 +168,6 @@ private:
         check_host_index_++;
         break;
     }
-
-    return BT::NodeStatus::RUNNING;
   }
 
   void remove_duplicate_hosts(std::vector<std::shared_ptr<ShutdownHost>> & hosts)
@@ -143,10 +191,10 @@ private:
       hosts.end());
   }
 
-  void onHalted()
+  void on_cancel() override
   {
     for (auto & host : hosts_) {
-      host->close_connection();
+      host->cancel();
     }
   }
 };
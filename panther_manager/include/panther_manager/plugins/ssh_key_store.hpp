@@ -0,0 +1,97 @@
+#ifndef PANTHER_MANAGER_SSH_KEY_STORE_HPP_
+#define PANTHER_MANAGER_SSH_KEY_STORE_HPP_
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <libssh/libssh.h>
+
+#include <ros/console.h>
+#include <ros/this_node.h>
+
+namespace panther_manager
+{
+
+using SSHKey = std::shared_ptr<ssh_key_struct>;
+
+// private keys parsed once and shared read-only by all shutdown sessions, so authentication
+// doesn't search and parse key files at shutdown time
+class SSHKeyStore
+{
+public:
+  SSHKeyStore() { node_name_ = ros::this_node::getName(); }
+
+  // keys are loaded from disk only once, returns nullptr if key can't be loaded
+  SSHKey load(const std::string & path)
+  {
+    const auto full_path = expand_home(path);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = keys_.find(full_path);
+    if (it != keys_.end()) {
+      return it->second;
+    }
+
+    ssh_key key = nullptr;
+    SSHKey shared_key;
+    if (ssh_pki_import_privkey_file(full_path.c_str(), nullptr, nullptr, nullptr, &key) == SSH_OK) {
+      shared_key = SSHKey(key, ssh_key_free);
+      ROS_INFO("[%s] Loaded SSH key: %s", node_name_.c_str(), full_path.c_str());
+    } else {
+      ROS_WARN("[%s] Failed to load SSH key: %s", node_name_.c_str(), full_path.c_str());
+    }
+    keys_[full_path] = shared_key;
+    return shared_key;
+  }
+
+  // loads keys that would be tried by ssh_userauth_publickey_auto
+  void load_default_keys()
+  {
+    default_keys_loaded_ = true;
+    for (const auto & name : {"id_ed25519", "id_ecdsa", "id_rsa"}) {
+      const auto path = expand_home(std::string("~/.ssh/") + name);
+      if (!std::filesystem::exists(path)) {
+        continue;
+      }
+      if (auto key = load(path)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        default_keys_.push_back(key);
+      }
+    }
+  }
+
+  std::vector<SSHKey> get_default_keys() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return default_keys_;
+  }
+
+  // if true, default keys don't have to be searched again when authenticating
+  bool default_keys_loaded() const { return default_keys_loaded_; }
+
+private:
+  std::string node_name_;
+  mutable std::mutex mutex_;
+  std::map<std::string, SSHKey> keys_;
+  std::vector<SSHKey> default_keys_;
+  std::atomic_bool default_keys_loaded_{false};
+
+  static std::string expand_home(const std::string & path)
+  {
+    const char * home = std::getenv("HOME");
+    if (home && path.rfind("~/", 0) == 0) {
+      return std::string(home) + path.substr(1);
+    }
+    return path;
+  }
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_SSH_KEY_STORE_HPP_
@@ -0,0 +1,62 @@
+#ifndef PANTHER_MANAGER_STATE_SNAPSHOT_HPP_
+#define PANTHER_MANAGER_STATE_SNAPSHOT_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace panther_manager
+{
+
+// values restored after restart of the manager, has to be trivially copyable. Animation state is
+// not stored, as the lights controller may have restarted too and lost the animation
+struct ManagerState
+{
+  std::optional<double> battery_temp;
+  std::optional<double> battery_percent;
+  std::optional<double> cpu_temp;
+  std::optional<double> front_driver_temp;
+  std::optional<double> rear_driver_temp;
+};
+
+// keeps the last state in a memory-mapped file, so it survives restart of the node. Writing is a
+// plain memory copy guarded by a sequence counter, a snapshot interrupted by a crash is detected
+// and discarded on read
+class StateSnapshot
+{
+public:
+  // throws std::runtime_error if the file can't be opened or mapped
+  explicit StateSnapshot(const std::string & path);
+  ~StateSnapshot();
+
+  StateSnapshot(const StateSnapshot &) = delete;
+  StateSnapshot & operator=(const StateSnapshot &) = delete;
+
+  // stores state with the current wall time
+  void write(const ManagerState & state);
+
+  // returns stored state if it was written within max age, in seconds
+  std::optional<ManagerState> read(const double max_age) const;
+
+private:
+  static constexpr std::uint32_t magic_ = 0x504D5353;  // PMSS
+  static constexpr std::uint32_t version_ = 2;
+
+  struct Layout
+  {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t size;
+    // odd while the snapshot is written
+    std::atomic<std::uint32_t> sequence;
+    std::int64_t stamp_ns;
+    ManagerState state;
+  };
+
+  Layout * layout_ = nullptr;
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_STATE_SNAPSHOT_HPP_
@@ -0,0 +1,121 @@
+#ifndef PANTHER_MANAGER_TIME_WINDOW_AVERAGE_HPP_
+#define PANTHER_MANAGER_TIME_WINDOW_AVERAGE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include <ros/duration.h>
+#include <ros/time.h>
+
+#include <panther_utils/ring_buffer.hpp>
+
+namespace panther_manager
+{
+
+// average of samples with timestamps within the window ending at the last update time. Each sample
+// is added and removed once, so updates are O(1) amortized. When samples stop arriving the window
+// empties, the last average is kept and the filter reports it is stale. Before the first sample
+// filter has no data and returns the initial value.
+template <typename T>
+class TimeWindowAverage
+{
+public:
+  TimeWindowAverage(
+    const ros::Duration & window_duration, const T initial_value = T(0),
+    const std::size_t max_samples = 1024)
+  : window_duration_(window_duration),
+    samples_(max_samples),
+    sum_(T(0)),
+    last_average_(initial_value)
+  {
+  }
+
+  // samples with stamp older than the newest one are treated as if they arrived with it
+  void roll(const ros::Time & stamp, const T value)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto sample_stamp = samples_.empty() ? stamp : std::max(stamp, samples_.back().first);
+    if (samples_.full()) {
+      sum_ -= samples_.front().second;
+      samples_.pop();
+    }
+    samples_.push(std::make_pair(sample_stamp, value));
+    sum_ += value;
+    has_data_ = true;
+    evict(sample_stamp);
+  }
+
+  // sets average used until the first sample arrives, e.g. value restored after restart. Seeded
+  // filter reports it is stale
+  void seed(const T value)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!has_data_) {
+      last_average_ = value;
+      has_data_ = true;
+    }
+  }
+
+  // drops samples which are no longer in the window, should be called before reading the average
+  void update(const ros::Time & now)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    evict(now);
+  }
+
+  T get_average() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_average_;
+  }
+
+  // true if filter received a sample or was seeded
+  bool has_data() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return has_data_;
+  }
+
+  // no samples in the window although some were received before
+  bool is_stale() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return has_data_ && samples_.empty();
+  }
+
+  // there are samples in the window
+  bool is_valid() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !samples_.empty();
+  }
+
+private:
+  bool has_data_ = false;
+  const ros::Duration window_duration_;
+  panther_utils::RingBuffer<std::pair<ros::Time, T>> samples_;
+  T sum_;
+  T last_average_;
+  mutable std::mutex mutex_;
+
+  void evict(const ros::Time & now)
+  {
+    while (!samples_.empty() && now - samples_.front().first > window_duration_) {
+      sum_ -= samples_.front().second;
+      samples_.pop();
+    }
+
+    if (samples_.empty()) {
+      // avoid accumulating floating point error over time
+      sum_ = T(0);
+      return;
+    }
+    last_average_ = sum_ / static_cast<T>(samples_.size());
+  }
+};
+
+}  // namespace panther_manager
+
+#endif  // PANTHER_MANAGER_TIME_WINDOW_AVERAGE_HPP_
@@ -3,15 +3,13 @@
 #include <behaviortree_cpp/basic_types.h>
 #include <behaviortree_cpp/exceptions.h>
 
-#include <ros/console.h>
-
 namespace panther_manager
 {
 
 void CallSetBoolService::update_request(std_srvs::SetBool::Request & request)
 {
   bool data;
-  if (!getInput<bool>("data", data)) {
+  if (!data_port_.get(*this, data)) {
     throw BT::RuntimeError("[", name(), "] Failed to get input [data]");
   }
   request.data = data;
@@ -20,14 +18,12 @@ void CallSetBoolService::update_request(std_srvs::SetBool::Request & request)
 BT::NodeStatus CallSetBoolService::on_response(const std_srvs::SetBool::Response & response)
 {
   if (!response.success) {
-    ROS_ERROR(
-      "[%s] Failed to call %s service, message: %s", get_node_name().c_str(),
-      get_srv_name().c_str(), response.message.c_str());
+    get_logger().error(
+      "Failed to call %s service, message: %s", get_srv_name(), response.message);
     return BT::NodeStatus::FAILURE;
   }
-  ROS_DEBUG(
-    "[%s] Successfuly called %s service, message: %s", get_node_name().c_str(),
-    get_srv_name().c_str(), response.message.c_str());
+  get_logger().debug(
+    "Successfuly called %s service, message: %s", get_srv_name(), response.message);
   return BT::NodeStatus::SUCCESS;
 }
 
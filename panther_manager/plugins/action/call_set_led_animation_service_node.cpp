@@ -5,8 +5,6 @@
 #include <behaviortree_cpp/basic_types.h>
 #include <behaviortree_cpp/exceptions.h>
 
-#include <ros/console.h>
-
 namespace panther_manager
 {
 
@@ -14,34 +12,30 @@ void CallSetLedAnimationService::update_request(panther_msgs::SetLEDAnimation::R
 {
   bool repeating;
   unsigned animation_id;
-  std::string param;
 
-  if (!getInput<unsigned>("id", animation_id)) {
+  if (!id_port_.get(*this, animation_id)) {
     throw(BT::RuntimeError("[", name(), "] Failed to get input [id]"));
   }
-  if (!getInput<bool>("repeating", repeating)) {
+  if (!repeating_port_.get(*this, repeating)) {
     throw(BT::RuntimeError("[", name(), "] Failed to get input [repeating]"));
   }
-  if (!getInput<std::string>("param", param)) {
+  if (!param_port_.get(*this, request.animation.param)) {
     throw(BT::RuntimeError("[", name(), "] Failed to get input [param]"));
   }
 
   request.animation.id = animation_id;
-  request.animation.param = param;
   request.repeating = repeating;
 }
 
 BT::NodeStatus CallSetLedAnimationService::on_response(const panther_msgs::SetLEDAnimation::Response & response)
 {
   if (!response.success) {
-    ROS_ERROR(
-      "[%s] Failed to call %s service, message: %s", get_node_name().c_str(),
-      get_srv_name().c_str(), response.message.c_str());
+    get_logger().error(
+      "Failed to call %s service, message: %s", get_srv_name(), response.message);
     return BT::NodeStatus::FAILURE;
   }
-  ROS_DEBUG(
-    "[%s] Successfuly called %s service, message: %s", get_node_name().c_str(),
-    get_srv_name().c_str(), response.message.c_str());
+  get_logger().debug(
+    "Successfuly called %s service, message: %s", get_srv_name(), response.message);
   return BT::NodeStatus::SUCCESS;
 }
 
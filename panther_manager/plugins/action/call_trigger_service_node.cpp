@@ -2,22 +2,18 @@
 
 #include <behaviortree_cpp/basic_types.h>
 
-#include <ros/console.h>
-
 namespace panther_manager
 {
 
 BT::NodeStatus CallTriggerService::on_response(const std_srvs::Trigger::Response & response)
 {
   if (!response.success) {
-    ROS_ERROR(
-      "[%s] Failed to call %s service, message: %s", get_node_name().c_str(),
-      get_srv_name().c_str(), response.message.c_str());
+    get_logger().error(
+      "Failed to call %s service, message: %s", get_srv_name(), response.message);
     return BT::NodeStatus::FAILURE;
   }
-  ROS_DEBUG(
-    "[%s] Successfuly called %s service, message: %s", get_node_name().c_str(),
-    get_srv_name().c_str(), response.message.c_str());
+  get_logger().debug(
+    "Successfuly called %s service, message: %s", get_srv_name(), response.message);
   return BT::NodeStatus::SUCCESS;
 }
 
@@ -0,0 +1,53 @@
+#include <panther_manager/plugins/action/set_gpio_line_node.hpp>
+
+#include <string>
+
+#include <behaviortree_cpp/basic_types.h>
+#include <behaviortree_cpp/exceptions.h>
+
+#include <panther_manager/plugins/gpio_lines.hpp>
+
+namespace panther_manager
+{
+
+SetGPIOLine::SetGPIOLine(const std::string & name, const BT::NodeConfig & conf)
+: BT::SyncActionNode(name, conf)
+{
+  if (config().blackboard) {
+    config().blackboard->get("gpio_lines", gpio_lines_);
+  }
+}
+
+BT::NodeStatus SetGPIOLine::tick()
+{
+  if (!gpio_lines_) {
+    throw(BT::RuntimeError("[", name(), "] GPIO lines not found on blackboard"));
+  }
+
+  std::string line_name;
+  if (!getInput<std::string>("line_name", line_name)) {
+    throw(BT::RuntimeError("[", name(), "] Failed to get input [line_name]"));
+  }
+  bool data;
+  if (!getInput<bool>("data", data)) {
+    throw(BT::RuntimeError("[", name(), "] Failed to get input [data]"));
+  }
+
+  if (!gpio_lines_->has_line(line_name)) {
+    throw(BT::RuntimeError("[", name(), "] GPIO line ", line_name, " is not owned by manager"));
+  }
+
+  if (!gpio_lines_->set_value(line_name, data)) {
+    return BT::NodeStatus::FAILURE;
+  }
+
+  return BT::NodeStatus::SUCCESS;
+}
+
+}  // namespace panther_manager
+
+#include "behaviortree_cpp/bt_factory.h"
+BT_REGISTER_NODES(factory)
+{
+  factory.registerNodeType<panther_manager::SetGPIOLine>("SetGPIOLine");
+}
@@ -0,0 +1,73 @@
+#include <panther_manager/plugins/action/set_led_animation_node.hpp>
+
+#include <string>
+
+#include <behaviortree_cpp/basic_types.h>
+#include <behaviortree_cpp/exceptions.h>
+
+#include <panther_msgs/SetLEDAnimation.h>
+
+namespace panther_manager
+{
+
+SetLedAnimation::SetLedAnimation(const std::string & name, const BT::NodeConfig & conf)
+: BT::StatefulActionNode(name, conf),
+  id_port_(*this, "id"),
+  param_port_(*this, "param"),
+  repeating_port_(*this, "repeating"),
+  confirm_port_(*this, "confirm")
+{
+  if (config().blackboard) {
+    config().blackboard->get("led_animation_dispatcher", dispatcher_);
+  }
+}
+
+BT::NodeStatus SetLedAnimation::onStart()
+{
+  if (!dispatcher_) {
+    throw(BT::RuntimeError("[", name(), "] LED animation dispatcher not found on blackboard"));
+  }
+
+  unsigned animation_id;
+  panther_msgs::SetLEDAnimation::Request request;
+
+  if (!id_port_.get(*this, animation_id)) {
+    throw(BT::RuntimeError("[", name(), "] Failed to get input [id]"));
+  }
+  if (!repeating_port_.get(*this, request.repeating)) {
+    throw(BT::RuntimeError("[", name(), "] Failed to get input [repeating]"));
+  }
+  if (!param_port_.get(*this, request.animation.param)) {
+    throw(BT::RuntimeError("[", name(), "] Failed to get input [param]"));
+  }
+  if (!confirm_port_.get(*this, confirm_)) {
+    throw(BT::RuntimeError("[", name(), "] Failed to get input [confirm]"));
+  }
+
+  request.animation.id = animation_id;
+  // unconfirmed requests are retried by the dispatcher, confirmed ones by the tree on failure
+  ticket_ = dispatcher_->queue(request, !confirm_);
+
+  return confirm_ ? BT::NodeStatus::RUNNING : BT::NodeStatus::SUCCESS;
+}
+
+BT::NodeStatus SetLedAnimation::onRunning()
+{
+  switch (dispatcher_->get_status(ticket_)) {
+    case LEDAnimationRequestStatus::PENDING:
+      return BT::NodeStatus::RUNNING;
+    case LEDAnimationRequestStatus::SUCCESS:
+      return BT::NodeStatus::SUCCESS;
+    default:
+      // superseded request was never shown and lost result can't be confirmed
+      return BT::NodeStatus::FAILURE;
+  }
+}
+
+}  // namespace panther_manager
+
+#include "behaviortree_cpp/bt_factory.h"
+BT_REGISTER_NODES(factory)
+{
+  factory.registerNodeType<panther_manager::SetLedAnimation>("SetLedAnimation");
+}
@@ -53,9 +53,38 @@ void ShutdownHostsFromFile::update_hosts(std::vector<std::shared_ptr<ShutdownHos
     if (host["ping_for_success"]) {
       ping_for_success = host["ping_for_success"].as<bool>();
     }
+    std::string key_path = "";
+    if (host["key_path"]) {
+      key_path = host["key_path"].as<std::string>();
+    }
+
+    hosts.push_back(std::make_shared<ShutdownHost>(
+      ip, user, port, command, timeout, ping_for_success, get_ssh_keys(key_path),
+      search_default_keys()));
+  }
+}
 
-    hosts.push_back(
-      std::make_shared<ShutdownHost>(ip, user, port, command, timeout, ping_for_success));
+void ShutdownHostsFromFile::preload_ssh_keys()
+{
+  std::string shutdown_hosts_file;
+  if (
+    !ssh_key_store_ || !getInput<std::string>("shutdown_hosts_file", shutdown_hosts_file) ||
+    shutdown_hosts_file == "") {
+    return;
+  }
+
+  // file is loaded again on shutdown, where errors fail the node
+  try {
+    const auto shutdown_hosts = YAML::LoadFile(shutdown_hosts_file);
+    for (const auto & host : shutdown_hosts["hosts"]) {
+      if (host["key_path"]) {
+        ssh_key_store_->load(host["key_path"].as<std::string>());
+      }
+    }
+  } catch (const YAML::Exception & e) {
+    ROS_WARN(
+      "[%s] Failed to preload SSH keys from %s: %s", get_node_name().c_str(),
+      shutdown_hosts_file.c_str(), e.what());
   }
 }
 
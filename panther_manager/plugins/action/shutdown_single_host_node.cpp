@@ -44,8 +44,8 @@ void ShutdownSingleHost::update_hosts(std::vector<std::shared_ptr<ShutdownHost>>
     throw(BT::RuntimeError("[", name(), "] Failed to get input [ping_for_success]"));
   }
 
-  hosts.push_back(
-    std::make_shared<ShutdownHost>(ip, user, port, command, timeout, ping_for_success));
+  hosts.push_back(std::make_shared<ShutdownHost>(
+    ip, user, port, command, timeout, ping_for_success, get_ssh_keys(), search_default_keys()));
 }
 
 }  // namespace panther_manager
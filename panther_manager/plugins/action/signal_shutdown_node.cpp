@@ -1,22 +1,35 @@
 #include <panther_manager/plugins/action/signal_shutdown_node.hpp>
 
-#include <utility>
 #include <string>
 
 #include <behaviortree_cpp/basic_types.h>
 #include <behaviortree_cpp/exceptions.h>
 
+#include <panther_manager/plugins/event_channel.hpp>
+
 namespace panther_manager
 {
 
+SignalShutdown::SignalShutdown(const std::string & name, const BT::NodeConfig & conf)
+: BT::SyncActionNode(name, conf)
+{
+  if (config().blackboard) {
+    config().blackboard->get("event_channel", event_channel_);
+  }
+}
+
 BT::NodeStatus SignalShutdown::tick()
 {
+  if (!event_channel_) {
+    throw(BT::RuntimeError("[", name(), "] Event channel not found on blackboard"));
+  }
+
   auto reason = getInput<std::string>("reason").value();
 
-  std::pair<bool, std::string> signal_shutdown;
-  signal_shutdown.first = true;
-  signal_shutdown.second = reason;
-  config().blackboard->set<std::pair<bool, std::string>>("signal_shutdown", signal_shutdown);
+  // handled by the event thread, which starts the shutdown tree once the current tick returns
+  if (!event_channel_->push(ShutdownEvent{reason})) {
+    return BT::NodeStatus::FAILURE;
+  }
 
   return BT::NodeStatus::SUCCESS;
 }
@@ -27,4 +40,4 @@ BT::NodeStatus SignalShutdown::tick()
 BT_REGISTER_NODES(factory)
 {
   factory.registerNodeType<panther_manager::SignalShutdown>("SignalShutdown");
-}
\ No newline at end of file
+}
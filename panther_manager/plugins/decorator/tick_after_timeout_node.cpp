@@ -11,18 +11,24 @@ namespace panther_manager
 {
 
 TickAfterTimeout::TickAfterTimeout(const std::string & name, const BT::NodeConfig & conf)
-: BT::DecoratorNode(name, conf)
+: BT::DecoratorNode(name, conf), timeout_port_(*this, "timeout")
 {
+  float timeout;
+  if (timeout_port_.is_static() && timeout_port_.get(*this, timeout)) {
+    timeout_ = ros::Duration(timeout);
+  }
   last_success_time_ = ros::Time::now();
 }
 
 BT::NodeStatus TickAfterTimeout::tick()
 {
-  float timeout;
-  if (!getInput<float>("timeout", timeout)) {
-    throw(BT::RuntimeError("[", name(), "] Failed to get input [timeout]"));
+  if (!timeout_port_.is_static()) {
+    float timeout;
+    if (!timeout_port_.get(*this, timeout)) {
+      throw(BT::RuntimeError("[", name(), "] Failed to get input [timeout]"));
+    }
+    timeout_ = ros::Duration(timeout);
   }
-  timeout_ = ros::Duration(timeout);
 
   if (ros::Time::now() - last_success_time_ < timeout_) {
     return BT::NodeStatus::SKIPPED;
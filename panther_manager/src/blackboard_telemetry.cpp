@@ -0,0 +1,76 @@
+#include <panther_manager/blackboard_telemetry.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <ros/ros.h>
+
+#include <std_msgs/Float64MultiArray.h>
+#include <std_msgs/String.h>
+
+namespace panther_manager
+{
+
+BlackboardTelemetry::BlackboardTelemetry(
+  const std::shared_ptr<ros::NodeHandle> & ph, const double rate, const double keyframe_period)
+: rate_(rate), keyframe_period_(keyframe_period), ph_(ph)
+{
+}
+
+void BlackboardTelemetry::start()
+{
+  // -------------------------------
+  //   Publishers
+  // -------------------------------
+
+  keys_pub_ = ph_->advertise<std_msgs::String>("telemetry/keys", 1, true);
+  telemetry_pub_ = ph_->advertise<std_msgs::Float64MultiArray>("telemetry/delta", 10);
+
+  std_msgs::String keys;
+  for (const auto & entry : entries_) {
+    keys.data += (keys.data.empty() ? "" : "\n") + entry.name;
+  }
+  keys_pub_.publish(keys);
+
+  // at most pair of index and value for each entry
+  msg_.data.reserve(2 * entries_.size());
+
+  // -------------------------------
+  //   Timers
+  // -------------------------------
+
+  telemetry_timer_ = ph_->createTimer(
+    ros::Duration(1.0 / rate_), std::bind(&BlackboardTelemetry::telemetry_timer_cb, this));
+}
+
+void BlackboardTelemetry::telemetry_timer_cb()
+{
+  // keyframe with all entries lets late subscribers recover full state
+  const auto now = ros::Time::now();
+  const bool keyframe = (now - last_keyframe_time_).toSec() >= keyframe_period_;
+  if (keyframe) {
+    last_keyframe_time_ = now;
+  }
+
+  msg_.data.clear();
+  for (std::size_t i = 0; i < entries_.size(); i++) {
+    auto & entry = entries_[i];
+    double value;
+    if (!entry.read(value)) {
+      continue;
+    }
+    if (keyframe || !entry.published || value != entry.last_value) {
+      msg_.data.push_back(static_cast<double>(i));
+      msg_.data.push_back(value);
+      entry.last_value = value;
+      entry.published = true;
+    }
+  }
+
+  if (!msg_.data.empty()) {
+    telemetry_pub_.publish(msg_);
+  }
+}
+
+}  // namespace panther_manager
@@ -0,0 +1,114 @@
+#include <panther_manager/input_watchdog.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <ros/ros.h>
+
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <diagnostic_msgs/DiagnosticStatus.h>
+
+namespace panther_manager
+{
+
+InputWatchdog::InputWatchdog(const std::shared_ptr<ros::NodeHandle> & nh) : nh_(nh)
+{
+  node_name_ = ros::this_node::getName();
+}
+
+std::size_t InputWatchdog::add_input(const std::string & name, const ros::Duration & max_age)
+{
+  auto input = std::make_unique<Input>();
+  input->name = name;
+  input->max_age = max_age;
+  inputs_.push_back(std::move(input));
+  return inputs_.size() - 1;
+}
+
+void InputWatchdog::start()
+{
+  diagnostics_pub_ = nh_->advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 1);
+
+  const auto now = ros::Time::now().toNSec();
+  for (auto & input : inputs_) {
+    if (input->max_age.isZero()) {
+      continue;
+    }
+    if (!input->last_arrival_ns) {
+      input->last_arrival_ns = now;
+    }
+    auto & input_ref = *input;
+    input->timer = nh_->createTimer(
+      input->max_age, [this, &input_ref](const ros::TimerEvent &) { deadline_timer_cb(input_ref); },
+      true);
+  }
+
+  publish_diagnostics();
+}
+
+void InputWatchdog::notify(const std::size_t id)
+{
+  auto & input = *inputs_[id];
+  input.last_arrival_ns = ros::Time::now().toNSec();
+
+  if (input.stale.exchange(false)) {
+    ROS_INFO("[%s] Receiving %s messages again", node_name_.c_str(), input.name.c_str());
+    rearm_timer(input, input.max_age);
+    publish_diagnostics();
+  }
+}
+
+void InputWatchdog::deadline_timer_cb(Input & input)
+{
+  ros::Time last_arrival;
+  last_arrival.fromNSec(input.last_arrival_ns);
+  const auto age = ros::Time::now() - last_arrival;
+
+  // message arrived since timer was armed, wait until deadline of the last one
+  if (age < input.max_age) {
+    rearm_timer(input, input.max_age - age);
+    return;
+  }
+
+  input.stale = true;
+  ROS_WARN(
+    "[%s] No %s message for %.2f s, input is stale", node_name_.c_str(), input.name.c_str(),
+    age.toSec());
+  publish_diagnostics();
+}
+
+void InputWatchdog::rearm_timer(Input & input, const ros::Duration & timeout)
+{
+  // one-shot timer is restarted only after it is stopped
+  std::lock_guard<std::mutex> lock(timers_mutex_);
+  input.timer.stop();
+  input.timer.setPeriod(timeout);
+  input.timer.start();
+}
+
+void InputWatchdog::publish_diagnostics()
+{
+  std::lock_guard<std::mutex> lock(diagnostics_mutex_);
+
+  diagnostics_msg_.header.stamp = ros::Time::now();
+  diagnostics_msg_.status.resize(inputs_.size());
+  for (std::size_t i = 0; i < inputs_.size(); i++) {
+    const auto & input = *inputs_[i];
+    auto & status = diagnostics_msg_.status[i];
+    status.name = node_name_ + ": " + input.name + " input";
+    if (input.stale) {
+      status.level = diagnostic_msgs::DiagnosticStatus::STALE;
+      status.message = "No message within " + std::to_string(input.max_age.toSec()) + " s";
+    } else {
+      status.level = diagnostic_msgs::DiagnosticStatus::OK;
+      status.message = input.max_age.isZero() ? "Not monitored" : "Receiving messages";
+    }
+  }
+
+  diagnostics_pub_.publish(diagnostics_msg_);
+}
+
+}  // namespace panther_manager
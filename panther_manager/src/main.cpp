@@ -4,13 +4,21 @@
 
 #include <ros/ros.h>
 
+#include <panther_utils/realtime.hpp>
+
 int main(int argc, char ** argv)
 {
   ros::init(argc, argv, "manager_bt_node");
-  ros::AsyncSpinner spinner(0);
   auto nh = std::make_shared<ros::NodeHandle>();
   auto ph = std::make_shared<ros::NodeHandle>("~");
 
+  // spinner threads inherit scheduling policy and affinity of the main thread
+  panther_utils::RealtimeConfigurator realtime(*ph);
+  realtime.configure_process();
+  realtime.configure_thread("spinner");
+
+  ros::AsyncSpinner spinner(0);
+
   panther_manager::ManagerBTNode manager_bt_node(nh, ph);
 
   spinner.start();
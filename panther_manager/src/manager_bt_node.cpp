@@ -3,37 +3,62 @@
 #include <algorithm>
 #include <any>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
+#include <variant>
 #include <vector>
 
+#include <poll.h>
+
 #include <behaviortree_cpp/bt_factory.h>
 #include <behaviortree_cpp/loggers/groot2_publisher.h>
 #include <behaviortree_cpp/utils/shared_library.h>
 
+#include <ros/callback_queue.h>
 #include <ros/package.h>
 #include <ros/ros.h>
 
 #include <sensor_msgs/BatteryState.h>
 #include <std_msgs/Bool.h>
+#include <std_msgs/Float64.h>
+#include <std_srvs/Trigger.h>
 
 #include <panther_msgs/DriverState.h>
 #include <panther_msgs/IOState.h>
 #include <panther_msgs/LEDAnimation.h>
 #include <panther_msgs/SystemStatus.h>
 
-#include <panther_manager/moving_average.hpp>
+#include <panther_utils/async_logger.hpp>
+#include <panther_utils/realtime.hpp>
+#include <panther_utils/steady_clock.hpp>
+#include <panther_utils/tracepoints.hpp>
+
+#include <panther_manager/blackboard_telemetry.hpp>
+#include <panther_manager/input_watchdog.hpp>
+#include <panther_manager/plugins/event_channel.hpp>
+#include <panther_manager/plugins/gpio_lines.hpp>
+#include <panther_manager/plugins/led_animation_dispatcher.hpp>
 #include <panther_manager/plugins/plugin.hpp>
+#include <panther_manager/plugins/reactor.hpp>
+#include <panther_manager/plugins/ssh_key_store.hpp>
+#include <panther_manager/state_snapshot.hpp>
+#include <panther_manager/time_window_average.hpp>
 
 namespace panther_manager
 {
 
 ManagerBTNode::ManagerBTNode(
   const std::shared_ptr<ros::NodeHandle> & nh, const std::shared_ptr<ros::NodeHandle> & ph)
-: nh_(std::move(nh)), ph_(std::move(ph))
+: battery_percent_round_(std::numeric_limits<double>::quiet_NaN()),
+  realtime_(*ph),
+  nh_(std::move(nh)),
+  ph_(std::move(ph))
 {
   node_name_ = ros::this_node::getName();
 
@@ -48,10 +73,14 @@ ManagerBTNode::ManagerBTNode(
   const auto plugin_libs = ph_->param<std::vector<std::string>>("plugin_libs", default_plugin_libs);
   const auto ros_plugin_libs =
     ph_->param<std::vector<std::string>>("ros_plugin_libs", default_plugin_libs);
-  const auto battery_temp_window_len = ph_->param<int>("battery_temp_window_len", 6);
-  const auto battery_percent_window_len = ph->param<int>("battery_percent_window_len", 6);
-  const auto cpu_temp_window_len = ph_->param<int>("cpu_temp_window_len", 6);
-  const auto driver_temp_window_len = ph_->param<int>("driver_temp_window_len", 6);
+  const auto gpio_lines =
+    ph_->param<std::vector<std::string>>("gpio_lines", std::vector<std::string>());
+  const auto battery_temp_window_duration =
+    ph_->param<double>("battery_temp_window_duration", 1.0);
+  const auto battery_percent_window_duration =
+    ph_->param<double>("battery_percent_window_duration", 1.0);
+  const auto cpu_temp_window_duration = ph_->param<double>("cpu_temp_window_duration", 5.0);
+  const auto driver_temp_window_duration = ph_->param<double>("driver_temp_window_duration", 1.0);
   const auto shutdown_hosts_file = ph_->param<std::string>("shutdown_hosts_file", "");
 
   // lights tree params
@@ -71,12 +100,45 @@ ManagerBTNode::ManagerBTNode(
   const auto cpu_fan_off_temp = ph_->param<float>("safety/cpu_fan_off_temp", 60.0);
   const auto driver_fan_on_temp = ph_->param<float>("safety/driver_fan_on_temp", 45.0);
   const auto driver_fan_off_temp = ph_->param<float>("safety/driver_fan_off_temp", 35.0);
-
-  battery_temp_ma_ = std::make_unique<MovingAverage<double>>(battery_temp_window_len);
-  battery_percent_ma_ = std::make_unique<MovingAverage<double>>(battery_percent_window_len, 1.0);
-  cpu_temp_ma_ = std::make_unique<MovingAverage<double>>(cpu_temp_window_len);
-  front_driver_temp_ma_ = std::make_unique<MovingAverage<double>>(driver_temp_window_len);
-  rear_driver_temp_ma_ = std::make_unique<MovingAverage<double>>(driver_temp_window_len);
+  safety_reflex_ = ph_->param<bool>("safety/reflex", true);
+
+  // telemetry params
+  const auto telemetry_rate = ph_->param<double>("telemetry/rate", 2.0);
+  const auto telemetry_keyframe_period = ph_->param<double>("telemetry/keyframe_period", 10.0);
+
+  // state snapshot params, default file is unique per node so instances don't share snapshots
+  auto snapshot_suffix = node_name_;
+  std::replace(snapshot_suffix.begin(), snapshot_suffix.end(), '/', '_');
+  const auto state_snapshot_file = ph_->param<std::string>(
+    "state_snapshot/file", "/dev/shm/panther_manager_state" + snapshot_suffix);
+  const auto state_snapshot_max_age = ph_->param<double>("state_snapshot/max_age", 10.0);
+  const auto state_snapshot_period = ph_->param<double>("state_snapshot/period", 1.0);
+
+  // watchdog params
+  const auto battery_max_age = ph_->param<double>("watchdog/battery_max_age", 1.0);
+  const auto driver_state_max_age = ph_->param<double>("watchdog/driver_state_max_age", 1.0);
+  const auto io_state_max_age = ph_->param<double>("watchdog/io_state_max_age", 0.0);
+  const auto system_status_max_age = ph_->param<double>("watchdog/system_status_max_age", 3.0);
+
+  battery_temp_filter_ =
+    std::make_unique<TimeWindowAverage<double>>(ros::Duration(battery_temp_window_duration));
+  battery_percent_filter_ = std::make_unique<TimeWindowAverage<double>>(
+    ros::Duration(battery_percent_window_duration), 1.0);
+  cpu_temp_filter_ =
+    std::make_unique<TimeWindowAverage<double>>(ros::Duration(cpu_temp_window_duration));
+  front_driver_temp_filter_ =
+    std::make_unique<TimeWindowAverage<double>>(ros::Duration(driver_temp_window_duration));
+  rear_driver_temp_filter_ =
+    std::make_unique<TimeWindowAverage<double>>(ros::Duration(driver_temp_window_duration));
+
+  if (!state_snapshot_file.empty()) {
+    try {
+      state_snapshot_ = std::make_unique<StateSnapshot>(state_snapshot_file);
+      restore_state(state_snapshot_max_age);
+    } catch (const std::runtime_error & e) {
+      ROS_WARN("[%s] State snapshot disabled: %s", node_name_.c_str(), e.what());
+    }
+  }
 
   ROS_INFO("[%s] Register BehaviorTree from: %s", node_name_.c_str(), bt_project_file.c_str());
 
@@ -91,6 +153,14 @@ ManagerBTNode::ManagerBTNode(
 
   factory_.registerBehaviorTreeFromFile(bt_project_file);
 
+  // created before trees, so nodes can take them from the blackboard
+  event_channel_ = std::make_shared<EventChannel>();
+  reactor_ = std::make_shared<Reactor>();
+  // lines have to be released by the power board node, see its ~external_lines parameter
+  if (!gpio_lines.empty()) {
+    gpio_lines_ = std::make_shared<GPIOLines>(nh_, node_name_, gpio_lines);
+  }
+
   if (launch_safety_tree && !launch_shutdown_tree_) {
     ROS_ERROR(
       "[%s] Can't launch safety tree without shutdown tree. Killing node.", node_name_.c_str());
@@ -132,7 +202,11 @@ ManagerBTNode::ManagerBTNode(
        unsigned(sensor_msgs::BatteryState::POWER_SUPPLY_HEALTH_OVERHEAT)},
     };
 
+    led_animation_dispatcher_ =
+      std::make_shared<LEDAnimationDispatcher>(nh_, "lights/controller/set/animation");
+
     lights_config_ = create_bt_config(lights_initial_bb);
+    lights_config_.blackboard->set("led_animation_dispatcher", led_animation_dispatcher_);
     lights_tree_ = factory_.createTree("Lights", lights_config_.blackboard);
     lights_bt_publisher_ = std::make_unique<BT::Groot2Publisher>(lights_tree_, 5555);
   }
@@ -145,6 +219,8 @@ ManagerBTNode::ManagerBTNode(
       {"DRIVER_FAN_ON_TEMP", driver_fan_on_temp},
       {"CRITICAL_BAT_TEMP", critical_bat_temp_},
       {"FATAL_BAT_TEMP", fatal_bat_temp_},
+      // fan and AUX lines are set with SetGPIOLine instead of power board services
+      {"gpio_control", !gpio_lines.empty()},
       // battery health constants
       {"POWER_SUPPLY_HEALTH_UNKNOWN",
        unsigned(sensor_msgs::BatteryState::POWER_SUPPLY_HEALTH_UNKNOWN)},
@@ -173,15 +249,46 @@ ManagerBTNode::ManagerBTNode(
       {"SHUTDOWN_HOSTS_FILE", shutdown_hosts_file.c_str()},
     };
 
+    // parse SSH keys at startup instead of when shutdown is requested
+    ssh_key_store_ = std::make_shared<SSHKeyStore>();
+    ssh_key_store_->load_default_keys();
+
     shutdown_config_ = create_bt_config(shutdown_initial_bb);
+    shutdown_config_.blackboard->set("ssh_key_store", ssh_key_store_);
     shutdown_tree_ = factory_.createTree("Shutdown", shutdown_config_.blackboard);
     shutdown_bt_publisher_ = std::make_unique<BT::Groot2Publisher>(shutdown_tree_, 7777);
   }
 
+  // -------------------------------
+  //   Publishers
+  // -------------------------------
+
+  reflex_reaction_time_pub_ = ph_->advertise<std_msgs::Float64>("reflex_reaction_time", 10);
+  tree_reaction_time_pub_ = ph_->advertise<std_msgs::Float64>("tree_reaction_time", 10);
+
+  // -------------------------------
+  //   Service clients
+  // -------------------------------
+
+  // persistent, so the connection made by the first reflex is reused by later ones. roscpp
+  // connects on the first call, there is no way to open the link without calling the service
+  if (safety_reflex_) {
+    e_stop_trigger_client_ =
+      nh_->serviceClient<std_srvs::Trigger>("hardware/e_stop_trigger", true);
+  }
+
   // -------------------------------
   //   Subscribers
   // -------------------------------
 
+  input_watchdog_ = std::make_unique<InputWatchdog>(nh_);
+  battery_input_id_ = input_watchdog_->add_input("battery", ros::Duration(battery_max_age));
+  driver_state_input_id_ =
+    input_watchdog_->add_input("driver_state", ros::Duration(driver_state_max_age));
+  io_state_input_id_ = input_watchdog_->add_input("io_state", ros::Duration(io_state_max_age));
+  system_status_input_id_ =
+    input_watchdog_->add_input("system_status", ros::Duration(system_status_max_age));
+
   battery_sub_ = nh_->subscribe("battery", 10, &ManagerBTNode::battery_cb, this);
   driver_state_sub_ =
     nh_->subscribe("driver/motor_controllers_state", 10, &ManagerBTNode::driver_state_cb, this);
@@ -190,19 +297,19 @@ ManagerBTNode::ManagerBTNode(
   system_status_sub_ = nh_->subscribe("system_status", 10, &ManagerBTNode::system_status_cb, this);
 
   ros::Rate rate(10.0);  // 10Hz
-  while (ros::ok() && !e_stop_state_.has_value()) {
+  while (ros::ok() && e_stop_state_ == e_stop_unknown_) {
     ROS_INFO_THROTTLE(5.0, "[%s] Waiting for e_stop message to arrive", node_name_.c_str());
     rate.sleep();
     ros::spinOnce();
   }
 
-  while (ros::ok() && !io_state_.has_value()) {
+  while (ros::ok() && !io_input_.load().received) {
     ROS_INFO_THROTTLE(5.0, "[%s] Waiting for io_state message to arrive", node_name_.c_str());
     rate.sleep();
     ros::spinOnce();
   }
 
-  while (ros::ok() && !battery_status_.has_value()) {
+  while (ros::ok() && !battery_input_.load().received) {
     ROS_INFO_THROTTLE(5.0, "[%s] Waiting for battery message to arrive", node_name_.c_str());
     rate.sleep();
     ros::spinOnce();
@@ -212,18 +319,77 @@ ManagerBTNode::ManagerBTNode(
   //   Timers
   // -------------------------------
 
+  input_watchdog_->start();
+
+  // trees are ticked by dedicated threads so they don't wait for other callbacks
   if (launch_lights_tree) {
-    lights_tree_timer_ =
-      nh_->createTimer(ros::Duration(0.1), std::bind(&ManagerBTNode::lights_tree_timer_cb, this));
+    lights_tree_timer_ = nh_->createTimer(ros::TimerOptions(
+      ros::Duration(0.1), std::bind(&ManagerBTNode::lights_tree_timer_cb, this),
+      &lights_tree_queue_));
+    lights_tree_thread_ =
+      std::thread(&ManagerBTNode::tree_thread, this, std::ref(lights_tree_queue_), "lights_tick");
   }
   if (launch_safety_tree) {
-    safety_tree_timer_ =
-      nh_->createTimer(ros::Duration(0.1), std::bind(&ManagerBTNode::safety_tree_timer_cb, this));
+    safety_tree_timer_ = nh_->createTimer(ros::TimerOptions(
+      ros::Duration(0.1), std::bind(&ManagerBTNode::safety_tree_timer_cb, this),
+      &safety_tree_queue_));
+    safety_tree_thread_ =
+      std::thread(&ManagerBTNode::tree_thread, this, std::ref(safety_tree_queue_), "safety_tick");
+  }
+
+  event_thread_ = std::thread(&ManagerBTNode::event_thread, this);
+
+  if (state_snapshot_ && state_snapshot_period > 0.0) {
+    state_snapshot_timer_ = nh_->createWallTimer(
+      ros::WallDuration(state_snapshot_period),
+      std::bind(&ManagerBTNode::state_snapshot_timer_cb, this));
+  }
+
+  if (telemetry_rate > 0.0) {
+    telemetry_ =
+      std::make_unique<BlackboardTelemetry>(ph_, telemetry_rate, telemetry_keyframe_period);
+    if (launch_lights_tree) {
+      const auto & bb = lights_config_.blackboard;
+      telemetry_->add_entry<bool>("lights", bb, "e_stop_state");
+      telemetry_->add_entry<unsigned>("lights", bb, "battery_status");
+      telemetry_->add_entry<unsigned>("lights", bb, "battery_health");
+      telemetry_->add_entry<float>("lights", bb, "battery_percent");
+      telemetry_->add_entry<int>("lights", bb, "current_anim_id");
+    }
+    if (launch_safety_tree) {
+      const auto & bb = safety_config_.blackboard;
+      telemetry_->add_entry<bool>("safety", bb, "aux_state");
+      telemetry_->add_entry<bool>("safety", bb, "e_stop_state");
+      telemetry_->add_entry<bool>("safety", bb, "fan_state");
+      telemetry_->add_entry<unsigned>("safety", bb, "battery_status");
+      telemetry_->add_entry<unsigned>("safety", bb, "battery_health");
+      telemetry_->add_entry<double>("safety", bb, "bat_temp");
+      telemetry_->add_entry<double>("safety", bb, "cpu_temp");
+      telemetry_->add_entry<double>("safety", bb, "driver_temp");
+    }
+    telemetry_->add_value(
+      "manager", "shutdown_requested", [this]() { return double(shutdown_started_.load()); });
+    telemetry_->start();
   }
 
   ROS_INFO("[%s] Node started", node_name_.c_str());
 }
 
+ManagerBTNode::~ManagerBTNode()
+{
+  lights_tree_timer_.stop();
+  safety_tree_timer_.stop();
+  if (lights_tree_thread_.joinable()) {
+    lights_tree_thread_.join();
+  }
+  if (safety_tree_thread_.joinable()) {
+    safety_tree_thread_.join();
+  }
+  if (event_thread_.joinable()) {
+    event_thread_.join();
+  }
+}
+
 BT::NodeConfig ManagerBTNode::create_bt_config(
   const std::map<std::string, std::any> & bb_values) const
 {
@@ -231,6 +397,11 @@ BT::NodeConfig ManagerBTNode::create_bt_config(
   config.blackboard = BT::Blackboard::create();
   // update blackboard
   config.blackboard->set("nh", nh_);
+  config.blackboard->set("event_channel", event_channel_);
+  config.blackboard->set("reactor", reactor_);
+  if (gpio_lines_) {
+    config.blackboard->set("gpio_lines", gpio_lines_);
+  }
   for (auto & item : bb_values) {
     const std::type_info & type = item.second.type();
     if (type == typeid(bool)) {
@@ -261,86 +432,232 @@ BT::NodeConfig ManagerBTNode::create_bt_config(
 
 void ManagerBTNode::battery_cb(const sensor_msgs::BatteryState::ConstPtr & battery)
 {
-  battery_status_ = battery->power_supply_status;
-  battery_health_ = battery->power_supply_health;
+  input_watchdog_->notify(battery_input_id_);
+  const unsigned status = battery->power_supply_status;
+  const unsigned health = battery->power_supply_health;
+  battery_input_.store({true, status, health});
   // don't update battery data if unknown status
-  if (battery_status_ == sensor_msgs::BatteryState::POWER_SUPPLY_STATUS_UNKNOWN) {
+  if (status == sensor_msgs::BatteryState::POWER_SUPPLY_STATUS_UNKNOWN) {
     return;
   }
-  if (battery_health_ == sensor_msgs::BatteryState::POWER_SUPPLY_HEALTH_UNKNOWN) {
+  if (health == sensor_msgs::BatteryState::POWER_SUPPLY_HEALTH_UNKNOWN) {
     return;
   }
 
-  battery_temp_ma_->roll(battery->temperature);
-  battery_percent_ma_->roll(battery->percentage);
+  const auto stamp = get_stamp(*battery);
+  battery_temp_filter_->roll(stamp, battery->temperature);
+  battery_percent_filter_->roll(stamp, battery->percentage);
+
+  if (safety_reflex_) {
+    safety_reflex(health);
+  }
+}
+
+void ManagerBTNode::safety_reflex(const unsigned battery_health)
+{
+  // minimal subset of safety tree conditions requiring E-stop
+  const bool critical =
+    battery_health == sensor_msgs::BatteryState::POWER_SUPPLY_HEALTH_OVERVOLTAGE ||
+    (battery_health == sensor_msgs::BatteryState::POWER_SUPPLY_HEALTH_OVERHEAT &&
+     battery_temp_filter_->get_average() > critical_bat_temp_);
+
+  if (!critical) {
+    reflex_triggered_ = false;
+    return;
+  }
+
+  // react only once for each occurrence of critical condition
+  if (reflex_triggered_.exchange(true)) {
+    return;
+  }
+
+  const auto detection_time = panther_utils::steady_now_ns();
+  critical_condition_time_ = detection_time;
+
+  if (e_stop_state_ == 1) {
+    return;
+  }
+
+  if (!e_stop_trigger_client_.isValid()) {
+    e_stop_trigger_client_ =
+      nh_->serviceClient<std_srvs::Trigger>("hardware/e_stop_trigger", true);
+  }
+
+  std_srvs::Trigger srv;
+  if (!e_stop_trigger_client_.call(srv) || !srv.response.success) {
+    // retried with the next Battery message while the condition lasts
+    reflex_triggered_ = false;
+    logger_.error("Safety reflex failed to trigger E-stop");
+    return;
+  }
+
+  publish_reaction_time(reflex_reaction_time_pub_, detection_time);
+  logger_.warn("Safety reflex triggered E-stop");
 }
 
 void ManagerBTNode::driver_state_cb(const panther_msgs::DriverState::ConstPtr & driver_state)
 {
-  front_driver_temp_ma_->roll(driver_state->front.temperature);
-  rear_driver_temp_ma_->roll(driver_state->rear.temperature);
+  input_watchdog_->notify(driver_state_input_id_);
+  const auto stamp = get_stamp(*driver_state);
+  front_driver_temp_filter_->roll(stamp, driver_state->front.temperature);
+  rear_driver_temp_filter_->roll(stamp, driver_state->rear.temperature);
 }
 
 void ManagerBTNode::e_stop_cb(const std_msgs::Bool::ConstPtr & e_stop)
 {
-  e_stop_state_ = e_stop->data;
+  e_stop_state_ = e_stop->data ? 1 : 0;
 }
 
 void ManagerBTNode::io_state_cb(const panther_msgs::IOState::ConstPtr & io_state)
 {
+  input_watchdog_->notify(io_state_input_id_);
   if (io_state->power_button && launch_shutdown_tree_) {
     shutdown_robot("Power button pressed");
   }
-  io_state_ = io_state;
+  io_input_.store({true, bool(io_state->aux_power), bool(io_state->fan)});
 }
 
 void ManagerBTNode::system_status_cb(const panther_msgs::SystemStatus::ConstPtr & system_status)
 {
-  cpu_temp_ma_->roll(system_status->cpu_temp);
+  input_watchdog_->notify(system_status_input_id_);
+  cpu_temp_filter_->roll(get_stamp(*system_status), system_status->cpu_temp);
 }
 
 void ManagerBTNode::lights_tree_timer_cb()
 {
+  battery_percent_filter_->update(ros::Time::now());
+
   // update blackboard
-  lights_config_.blackboard->set<bool>("e_stop_state", e_stop_state_.value());
-  lights_config_.blackboard->set<unsigned>("battery_status", battery_status_.value());
-  lights_config_.blackboard->set<unsigned>("battery_health", battery_health_.value());
-  lights_config_.blackboard->set<float>("battery_percent", battery_percent_ma_->get_average());
-  lights_config_.blackboard->set<std::string>(
-    "battery_percent_round",
-    std::to_string(
-      round(battery_percent_ma_->get_average() / update_charging_anim_step_) *
-      update_charging_anim_step_));
+  const auto battery = battery_input_.load();
+  lights_config_.blackboard->set<bool>("e_stop_state", e_stop_state_ == 1);
+  lights_config_.blackboard->set<unsigned>("battery_status", battery.status);
+  lights_config_.blackboard->set<unsigned>("battery_health", battery.health);
+  lights_config_.blackboard->set<bool>(
+    "battery_stale", input_watchdog_->is_stale(battery_input_id_));
+  lights_config_.blackboard->set<float>("battery_percent", battery_percent_filter_->get_average());
+  lights_config_.blackboard->set<bool>(
+    "battery_percent_valid", battery_percent_filter_->is_valid());
+  // string entry is allocated on each set, so it is updated only when the rounded value changes
+  const double battery_percent_round =
+    round(battery_percent_filter_->get_average() / update_charging_anim_step_) *
+    update_charging_anim_step_;
+  if (battery_percent_round != battery_percent_round_) {
+    battery_percent_round_ = battery_percent_round;
+    lights_config_.blackboard->set<std::string>(
+      "battery_percent_round", std::to_string(battery_percent_round));
+  }
 
+  PANTHER_TRACEPOINT(tree_tick_begin, "lights");
   lights_tree_status_ = lights_tree_.tickOnce();
+  PANTHER_TRACEPOINT(tree_tick_end, "lights", static_cast<int>(lights_tree_status_));
+  // send only the last animation requested during this tick
+  led_animation_dispatcher_->flush();
+}
+
+void ManagerBTNode::state_snapshot_timer_cb()
+{
+  const auto filter_value =
+    [](const std::unique_ptr<TimeWindowAverage<double>> & filter) -> std::optional<double> {
+    if (!filter->has_data()) {
+      return std::nullopt;
+    }
+    return filter->get_average();
+  };
+
+  ManagerState state;
+  state.battery_temp = filter_value(battery_temp_filter_);
+  state.battery_percent = filter_value(battery_percent_filter_);
+  state.cpu_temp = filter_value(cpu_temp_filter_);
+  state.front_driver_temp = filter_value(front_driver_temp_filter_);
+  state.rear_driver_temp = filter_value(rear_driver_temp_filter_);
+
+  state_snapshot_->write(state);
+}
+
+void ManagerBTNode::restore_state(const double max_age)
+{
+  const auto state = state_snapshot_->read(max_age);
+  if (!state) {
+    return;
+  }
+
+  const auto seed = [](TimeWindowAverage<double> & filter, const std::optional<double> & value) {
+    if (value) {
+      filter.seed(value.value());
+    }
+  };
+  seed(*battery_temp_filter_, state->battery_temp);
+  seed(*battery_percent_filter_, state->battery_percent);
+  seed(*cpu_temp_filter_, state->cpu_temp);
+  seed(*front_driver_temp_filter_, state->front_driver_temp);
+  seed(*rear_driver_temp_filter_, state->rear_driver_temp);
+
+  ROS_INFO("[%s] Restored state from snapshot", node_name_.c_str());
 }
 
 void ManagerBTNode::safety_tree_timer_cb()
 {
+  // critical condition detected before updating blackboard will be handled by this tick
+  const auto detection_time = critical_condition_time_.exchange(0);
+
+  const auto now = ros::Time::now();
+  battery_temp_filter_->update(now);
+  cpu_temp_filter_->update(now);
+  front_driver_temp_filter_->update(now);
+  rear_driver_temp_filter_->update(now);
+
   // update blackboard
-  safety_config_.blackboard->set<bool>("aux_state", io_state_.value()->aux_power);
-  safety_config_.blackboard->set<bool>("e_stop_state", e_stop_state_.value());
-  safety_config_.blackboard->set<bool>("fan_state", io_state_.value()->fan);
-  safety_config_.blackboard->set<unsigned>("battery_status", battery_status_.value());
-  safety_config_.blackboard->set<unsigned>("battery_health", battery_health_.value());
-  safety_config_.blackboard->set<double>("bat_temp", battery_temp_ma_->get_average());
-  safety_config_.blackboard->set<double>("cpu_temp", cpu_temp_ma_->get_average());
+  const auto battery = battery_input_.load();
+  const auto io = io_input_.load();
+  safety_config_.blackboard->set<bool>("aux_state", io.aux_power);
+  safety_config_.blackboard->set<bool>("e_stop_state", e_stop_state_ == 1);
+  safety_config_.blackboard->set<bool>("fan_state", io.fan);
+  safety_config_.blackboard->set<unsigned>("battery_status", battery.status);
+  safety_config_.blackboard->set<unsigned>("battery_health", battery.health);
+  safety_config_.blackboard->set<double>("bat_temp", battery_temp_filter_->get_average());
+  safety_config_.blackboard->set<double>("cpu_temp", cpu_temp_filter_->get_average());
   // to simplify conditions pass only higher temp of motor drivers
   safety_config_.blackboard->set<double>(
     "driver_temp",
-    std::max({front_driver_temp_ma_->get_average(), rear_driver_temp_ma_->get_average()}));
-
+    std::max({front_driver_temp_filter_->get_average(), rear_driver_temp_filter_->get_average()}));
+  safety_config_.blackboard->set<bool>("bat_temp_valid", battery_temp_filter_->is_valid());
+  safety_config_.blackboard->set<bool>("cpu_temp_valid", cpu_temp_filter_->is_valid());
+  safety_config_.blackboard->set<bool>(
+    "driver_temp_valid",
+    front_driver_temp_filter_->is_valid() && rear_driver_temp_filter_->is_valid());
+  safety_config_.blackboard->set<bool>(
+    "battery_stale", input_watchdog_->is_stale(battery_input_id_));
+  safety_config_.blackboard->set<bool>(
+    "driver_state_stale", input_watchdog_->is_stale(driver_state_input_id_));
+  safety_config_.blackboard->set<bool>(
+    "io_state_stale", input_watchdog_->is_stale(io_state_input_id_));
+  safety_config_.blackboard->set<bool>(
+    "system_status_stale", input_watchdog_->is_stale(system_status_input_id_));
+
+  PANTHER_TRACEPOINT(tree_tick_begin, "safety");
   safety_tree_status_ = safety_tree_.tickOnce();
+  PANTHER_TRACEPOINT(tree_tick_end, "safety", static_cast<int>(safety_tree_status_));
 
-  std::pair<bool, std::string> signal_shutdown;
-  if (safety_config_.blackboard->get<std::pair<bool, std::string>>(
-        "signal_shutdown", signal_shutdown)) {
-    if (signal_shutdown.first) shutdown_robot(signal_shutdown.second);
+  if (detection_time) {
+    publish_reaction_time(tree_reaction_time_pub_, detection_time);
   }
 }
 
+void ManagerBTNode::publish_reaction_time(
+  const ros::Publisher & pub, const std::int64_t detection_time)
+{
+  std_msgs::Float64 reaction_time;
+  reaction_time.data = (panther_utils::steady_now_ns() - detection_time) * 1e-9;
+  pub.publish(reaction_time);
+}
+
 void ManagerBTNode::shutdown_robot(const std::string & reason)
 {
+  // shutdown can be requested from callbacks, trees and the event channel at the same time
+  if (shutdown_started_.exchange(true)) {
+    return;
+  }
+
   ROS_WARN("[%s] Soft shutdown initialized. %s", node_name_.c_str(), reason.c_str());
   lights_tree_timer_.stop();
   lights_tree_.haltTree();
@@ -352,10 +669,48 @@ void ManagerBTNode::shutdown_robot(const std::string & reason)
   auto start_time = ros::Time::now();
   ros::Rate rate(30.0);  // 30 Hz
   while (ros::ok() && shutdown_tree_status_ == BT::NodeStatus::RUNNING) {
+    PANTHER_TRACEPOINT(tree_tick_begin, "shutdown");
     shutdown_tree_status_ = shutdown_tree_.tickOnce();
+    PANTHER_TRACEPOINT(tree_tick_end, "shutdown", static_cast<int>(shutdown_tree_status_));
     rate.sleep();
   }
   ros::requestShutdown();
 }
 
+void ManagerBTNode::tree_thread(ros::CallbackQueue & queue, const std::string & realtime_role)
+{
+  realtime_.configure_thread(realtime_role);
+  while (ros::ok()) {
+    queue.callAvailable(ros::WallDuration(0.1));
+  }
+}
+
+void ManagerBTNode::event_thread()
+{
+  // shutdown tree is ticked by this thread when requested by an event
+  realtime_.configure_thread("safety_tick");
+
+  pollfd fd = {event_channel_->get_fd(), POLLIN, 0};
+  ManagerEvent event;
+  while (ros::ok()) {
+    if (poll(&fd, 1, 100) <= 0) {
+      continue;
+    }
+    // clear before draining, so events pushed meanwhile wake the next poll
+    event_channel_->clear_notification();
+    while (event_channel_->pop(event)) {
+      handle_event(event);
+    }
+  }
+}
+
+void ManagerBTNode::handle_event(const ManagerEvent & event)
+{
+  if (const auto shutdown = std::get_if<ShutdownEvent>(&event)) {
+    if (launch_shutdown_tree_) {
+      shutdown_robot(shutdown->reason);
+    }
+  }
+}
+
 }  // namespace panther_manager
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <behaviortree_cpp/bt_factory.h>
+
+#include <ros/ros.h>
+
+#include <panther_utils/histogram.hpp>
+#include <panther_utils/steady_clock.hpp>
+
+#include <panther_manager/plugins/action/call_set_bool_service_node.hpp>
+#include <panther_manager/plugins/action/call_set_led_animation_service_node.hpp>
+#include <panther_manager/plugins/action/call_trigger_service_node.hpp>
+
+namespace
+{
+
+struct BenchmarkCase
+{
+  std::string name;
+  std::string xml;
+};
+
+// each thread ticks its own tree, as tree nodes are not thread safe
+void run_case(
+  BT::BehaviorTreeFactory & factory, const BenchmarkCase & benchmark_case, const int concurrency,
+  const int iterations)
+{
+  const auto node_name = ros::this_node::getName();
+  panther_utils::Histogram tick_time_hist;
+  std::atomic<std::uint64_t> failures{0};
+
+  factory.registerBehaviorTreeFromText(benchmark_case.xml);
+  std::vector<BT::Tree> trees;
+  for (int i = 0; i < concurrency; i++) {
+    trees.push_back(factory.createTree(benchmark_case.name));
+  }
+
+  std::vector<std::thread> threads;
+  for (auto & tree : trees) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < iterations && ros::ok(); i++) {
+        const panther_utils::Stopwatch stopwatch;
+        const auto status = tree.tickOnce();
+        tick_time_hist.record(stopwatch.elapsed_ns());
+        if (status != BT::NodeStatus::SUCCESS) {
+          failures++;
+        }
+        tree.haltTree();
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  ROS_INFO(
+    "[%s] %s tick time [ms]:\n"
+    "  samples: %lu, failures: %lu\n"
+    "  p50: %.3f, p90: %.3f, p99: %.3f, p99.9: %.3f, max: %.3f",
+    node_name.c_str(), benchmark_case.name.c_str(), tick_time_hist.count(), failures.load(),
+    tick_time_hist.percentile(50.0) * 1e-6, tick_time_hist.percentile(90.0) * 1e-6,
+    tick_time_hist.percentile(99.0) * 1e-6, tick_time_hist.percentile(99.9) * 1e-6,
+    tick_time_hist.max() * 1e-6);
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  ros::init(argc, argv, "service_call_benchmark_node");
+  auto nh = std::make_shared<ros::NodeHandle>();
+  ros::NodeHandle ph("~");
+
+  const auto concurrency = ph.param<int>("concurrency", 4);
+  const auto iterations = ph.param<int>("iterations", 500);
+  const auto startup_timeout = ph.param<double>("startup_timeout", 10.0);
+
+  BT::BehaviorTreeFactory factory;
+  factory.registerNodeType<panther_manager::CallSetBoolService>("CallSetBoolService", nh);
+  factory.registerNodeType<panther_manager::CallTriggerService>("CallTriggerService", nh);
+  factory.registerNodeType<panther_manager::CallSetLedAnimationService>(
+    "CallSetLedAnimationService", nh);
+
+  const std::vector<BenchmarkCase> cases = {
+    {"CallSetBoolService",
+     R"(<root BTCPP_format="4"><BehaviorTree ID="CallSetBoolService">
+          <CallSetBoolService service_name="benchmark/set_bool" data="true" timeout="1000"/>
+        </BehaviorTree></root>)"},
+    {"CallTriggerService",
+     R"(<root BTCPP_format="4"><BehaviorTree ID="CallTriggerService">
+          <CallTriggerService service_name="benchmark/trigger" timeout="1000"/>
+        </BehaviorTree></root>)"},
+    {"CallSetLedAnimationService",
+     R"(<root BTCPP_format="4"><BehaviorTree ID="CallSetLedAnimationService">
+          <CallSetLedAnimationService service_name="benchmark/set_animation" id="0" param=""
+                                      repeating="false" timeout="1000"/>
+        </BehaviorTree></root>)"},
+  };
+
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  for (const auto & service :
+       {"benchmark/set_bool", "benchmark/trigger", "benchmark/set_animation"}) {
+    if (!ros::service::waitForService(service, ros::Duration(startup_timeout))) {
+      ROS_ERROR(
+        "[%s] Service %s is not available, check if service_stub_node is running",
+        ros::this_node::getName().c_str(), service);
+      return 1;
+    }
+  }
+
+  ROS_INFO(
+    "[%s] Measuring %d iterations in %d concurrent threads", ros::this_node::getName().c_str(),
+    iterations, concurrency);
+
+  for (const auto & benchmark_case : cases) {
+    run_case(factory, benchmark_case, concurrency, iterations);
+  }
+
+  ros::shutdown();
+  return 0;
+}
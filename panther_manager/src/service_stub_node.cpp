@@ -0,0 +1,56 @@
+#include <memory>
+
+#include <ros/ros.h>
+
+#include <std_srvs/SetBool.h>
+#include <std_srvs/Trigger.h>
+
+#include <panther_msgs/SetLEDAnimation.h>
+
+// serves services called by default trees, responding after configurable latency
+int main(int argc, char ** argv)
+{
+  ros::init(argc, argv, "service_stub_node");
+  ros::NodeHandle nh;
+  ros::NodeHandle ph("~");
+
+  const auto response_latency = ros::WallDuration(ph.param<double>("response_latency", 0.0));
+  const auto spinner_threads = ph.param<int>("spinner_threads", 4);
+
+  using SetBoolReq = std_srvs::SetBool::Request;
+  using SetBoolRes = std_srvs::SetBool::Response;
+  using TriggerReq = std_srvs::Trigger::Request;
+  using TriggerRes = std_srvs::Trigger::Response;
+  using SetAnimationReq = panther_msgs::SetLEDAnimation::Request;
+  using SetAnimationRes = panther_msgs::SetLEDAnimation::Response;
+
+  auto set_bool_server = nh.advertiseService<SetBoolReq, SetBoolRes>(
+    "benchmark/set_bool", [&](SetBoolReq &, SetBoolRes & res) {
+      response_latency.sleep();
+      res.success = true;
+      return true;
+    });
+
+  auto trigger_server = nh.advertiseService<TriggerReq, TriggerRes>(
+    "benchmark/trigger", [&](TriggerReq &, TriggerRes & res) {
+      response_latency.sleep();
+      res.success = true;
+      return true;
+    });
+
+  auto set_animation_server = nh.advertiseService<SetAnimationReq, SetAnimationRes>(
+    "benchmark/set_animation", [&](SetAnimationReq &, SetAnimationRes & res) {
+      response_latency.sleep();
+      res.success = true;
+      return true;
+    });
+
+  ROS_INFO(
+    "[%s] Serving with response latency %.3f s", ros::this_node::getName().c_str(),
+    response_latency.toSec());
+
+  ros::AsyncSpinner spinner(spinner_threads);
+  spinner.start();
+  ros::waitForShutdown();
+  return 0;
+}
@@ -0,0 +1,88 @@
+#include <panther_manager/state_snapshot.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <ros/time.h>
+
+namespace panther_manager
+{
+
+StateSnapshot::StateSnapshot(const std::string & path)
+{
+  static_assert(std::is_trivially_copyable_v<ManagerState>);
+  static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+  }
+
+  // new file is zero filled, so it is rejected on read until the first write
+  if (ftruncate(fd, sizeof(Layout)) < 0) {
+    const int error = errno;
+    close(fd);
+    throw std::runtime_error("Failed to resize " + path + ": " + std::strerror(error));
+  }
+
+  void * addr = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    throw std::runtime_error("Failed to map " + path + ": " + std::strerror(errno));
+  }
+  layout_ = static_cast<Layout *>(addr);
+}
+
+StateSnapshot::~StateSnapshot()
+{
+  if (layout_) {
+    munmap(layout_, sizeof(Layout));
+  }
+}
+
+void StateSnapshot::write(const ManagerState & state)
+{
+  const auto sequence = layout_->sequence.load(std::memory_order_relaxed) | 1;
+  layout_->sequence.store(sequence, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  layout_->magic = magic_;
+  layout_->version = version_;
+  layout_->size = sizeof(Layout);
+  layout_->stamp_ns = ros::WallTime::now().toNSec();
+  layout_->state = state;
+
+  layout_->sequence.store(sequence + 1, std::memory_order_release);
+}
+
+std::optional<ManagerState> StateSnapshot::read(const double max_age) const
+{
+  const auto sequence = layout_->sequence.load(std::memory_order_acquire);
+  if (sequence & 1) {
+    return std::nullopt;
+  }
+
+  if (
+    layout_->magic != magic_ || layout_->version != version_ || layout_->size != sizeof(Layout)) {
+    return std::nullopt;
+  }
+
+  const auto age = (std::int64_t(ros::WallTime::now().toNSec()) - layout_->stamp_ns) * 1e-9;
+  if (age < 0.0 || age > max_age) {
+    return std::nullopt;
+  }
+
+  return layout_->state;
+}
+
+}  // namespace panther_manager
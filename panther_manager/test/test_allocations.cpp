@@ -0,0 +1,196 @@
+#include <cstddef>
+#include <string>
+
+#include <behaviortree_cpp/blackboard.h>
+#include <behaviortree_cpp/bt_factory.h>
+#include <gtest/gtest.h>
+
+#include <ros/duration.h>
+#include <ros/time.h>
+
+#include <panther_msgs/LEDAnimation.h>
+#include <sensor_msgs/BatteryState.h>
+
+#include <panther_utils/allocation_counter.hpp>
+
+#include <panther_manager/plugins/action/call_set_bool_service_node.hpp>
+#include <panther_manager/plugins/action/call_trigger_service_node.hpp>
+#include <panther_manager/plugins/action/set_gpio_line_node.hpp>
+#include <panther_manager/plugins/action/set_led_animation_node.hpp>
+#include <panther_manager/plugins/action/signal_shutdown_node.hpp>
+#include <panther_manager/plugins/decorator/tick_after_timeout_node.hpp>
+#include <panther_manager/time_window_average.hpp>
+
+// allocations allowed per call in steady state
+constexpr std::size_t filter_roll_budget = 0;
+constexpr std::size_t lights_tick_budget = 0;
+constexpr std::size_t safety_tick_budget = 0;
+
+namespace
+{
+constexpr int iterations = 1000;
+
+using sensor_msgs::BatteryState;
+
+template <typename T>
+void register_stub(BT::BehaviorTreeFactory & factory, const std::string & id)
+{
+  // services are stubbed, node succeeds without reading its ports
+  factory.registerSimpleAction(
+    id, [](BT::TreeNode &) { return BT::NodeStatus::SUCCESS; }, T::providedPorts());
+}
+}  // namespace
+
+class TestTreeAllocations : public testing::Test
+{
+protected:
+  TestTreeAllocations()
+  {
+    register_stub<panther_manager::CallSetBoolService>(factory_, "CallSetBoolService");
+    register_stub<panther_manager::CallTriggerService>(factory_, "CallTriggerService");
+    register_stub<panther_manager::SetGPIOLine>(factory_, "SetGPIOLine");
+    register_stub<panther_manager::SetLedAnimation>(factory_, "SetLedAnimation");
+    register_stub<panther_manager::SignalShutdown>(factory_, "SignalShutdown");
+    factory_.registerNodeType<panther_manager::TickAfterTimeout>("TickAfterTimeout");
+
+    factory_.registerBehaviorTreeFromFile(PANTHER_MANAGER_CONFIG_DIR "/lights.xml");
+    factory_.registerBehaviorTreeFromFile(PANTHER_MANAGER_CONFIG_DIR "/safety.xml");
+  }
+
+  // same entries as set by the manager
+  BT::Blackboard::Ptr create_lights_blackboard() const
+  {
+    auto bb = BT::Blackboard::create();
+    bb->set("charging_anim_percent", std::string(""));
+    bb->set("current_anim_id", -1);
+    bb->set("BATTERY_STATE_ANIM_PERIOD", 120.0);
+    bb->set("CRITICAL_BATTERY_ANIM_PERIOD", 15.0);
+    bb->set("CRITICAL_BATTERY_THRESHOLD_PERCENT", 0.1);
+    bb->set("LOW_BATTERY_ANIM_PERIOD", 30.0);
+    bb->set("LOW_BATTERY_THRESHOLD_PERCENT", 0.4);
+    bb->set("E_STOP_ANIM_ID", unsigned(panther_msgs::LEDAnimation::E_STOP));
+    bb->set("READY_ANIM_ID", unsigned(panther_msgs::LEDAnimation::READY));
+    bb->set("ERROR_ANIM_ID", unsigned(panther_msgs::LEDAnimation::ERROR));
+    bb->set("LOW_BATTERY_ANIM_ID", unsigned(panther_msgs::LEDAnimation::LOW_BATTERY));
+    bb->set("CRITICAL_BATTERY_ANIM_ID", unsigned(panther_msgs::LEDAnimation::CRITICAL_BATTERY));
+    bb->set("BATTERY_STATE_ANIM_ID", unsigned(panther_msgs::LEDAnimation::BATTERY_STATE));
+    bb->set("CHARGING_BATTERY_ANIM_ID", unsigned(panther_msgs::LEDAnimation::CHARGING_BATTERY));
+    bb->set("POWER_SUPPLY_STATUS_UNKNOWN", unsigned(BatteryState::POWER_SUPPLY_STATUS_UNKNOWN));
+    bb->set("POWER_SUPPLY_STATUS_CHARGING", unsigned(BatteryState::POWER_SUPPLY_STATUS_CHARGING));
+    bb->set(
+      "POWER_SUPPLY_STATUS_DISCHARGING", unsigned(BatteryState::POWER_SUPPLY_STATUS_DISCHARGING));
+    bb->set(
+      "POWER_SUPPLY_STATUS_NOT_CHARGING",
+      unsigned(BatteryState::POWER_SUPPLY_STATUS_NOT_CHARGING));
+    bb->set("POWER_SUPPLY_STATUS_FULL", unsigned(BatteryState::POWER_SUPPLY_STATUS_FULL));
+    bb->set("POWER_SUPPLY_HEALTH_OVERHEAT", unsigned(BatteryState::POWER_SUPPLY_HEALTH_OVERHEAT));
+
+    bb->set("e_stop_state", false);
+    bb->set("battery_status", unsigned(BatteryState::POWER_SUPPLY_STATUS_DISCHARGING));
+    bb->set("battery_health", unsigned(BatteryState::POWER_SUPPLY_HEALTH_GOOD));
+    bb->set("battery_stale", false);
+    bb->set("battery_percent", 0.7f);
+    bb->set("battery_percent_valid", true);
+    bb->set("battery_percent_round", std::string("0.700000"));
+    return bb;
+  }
+
+  BT::Blackboard::Ptr create_safety_blackboard() const
+  {
+    auto bb = BT::Blackboard::create();
+    bb->set("CPU_FAN_OFF_TEMP", 60.0);
+    bb->set("CPU_FAN_ON_TEMP", 70.0);
+    bb->set("DRIVER_FAN_OFF_TEMP", 35.0);
+    bb->set("DRIVER_FAN_ON_TEMP", 45.0);
+    bb->set("CRITICAL_BAT_TEMP", 59.0);
+    bb->set("FATAL_BAT_TEMP", 62.0);
+    bb->set("gpio_control", false);
+    bb->set("POWER_SUPPLY_HEALTH_GOOD", unsigned(BatteryState::POWER_SUPPLY_HEALTH_GOOD));
+    bb->set("POWER_SUPPLY_HEALTH_OVERHEAT", unsigned(BatteryState::POWER_SUPPLY_HEALTH_OVERHEAT));
+    bb->set("POWER_SUPPLY_HEALTH_DEAD", unsigned(BatteryState::POWER_SUPPLY_HEALTH_DEAD));
+    bb->set(
+      "POWER_SUPPLY_HEALTH_OVERVOLTAGE", unsigned(BatteryState::POWER_SUPPLY_HEALTH_OVERVOLTAGE));
+
+    bb->set("aux_state", true);
+    bb->set("e_stop_state", false);
+    bb->set("fan_state", true);
+    bb->set("battery_status", unsigned(BatteryState::POWER_SUPPLY_STATUS_DISCHARGING));
+    bb->set("battery_health", unsigned(BatteryState::POWER_SUPPLY_HEALTH_GOOD));
+    bb->set("bat_temp", 30.0);
+    bb->set("cpu_temp", 50.0);
+    bb->set("driver_temp", 30.0);
+    bb->set("bat_temp_valid", true);
+    bb->set("cpu_temp_valid", true);
+    bb->set("driver_temp_valid", true);
+    bb->set("battery_stale", false);
+    bb->set("driver_state_stale", false);
+    bb->set("io_state_stale", false);
+    bb->set("system_status_stale", false);
+    return bb;
+  }
+
+  // ticks the tree until it settles, then counts allocations of further ticks
+  static std::size_t count_tick_allocations(BT::Tree & tree)
+  {
+    for (int i = 0; i < 10; i++) {
+      tree.tickOnce();
+    }
+
+    panther_utils::AllocationCounter counter;
+    for (int i = 0; i < iterations; i++) {
+      tree.tickOnce();
+    }
+    return counter.count();
+  }
+
+  BT::BehaviorTreeFactory factory_;
+};
+
+TEST(TestAllocations, TimeWindowAverageRoll)
+{
+  panther_manager::TimeWindowAverage<double> filter(ros::Duration(1.0), 0.0, 64);
+  ros::Time stamp(1000.0);
+  const ros::Duration period(0.01);
+
+  // fills the window, so samples are evicted in the loop
+  for (int i = 0; i < 200; i++) {
+    stamp += period;
+    filter.roll(stamp, 20.0 + i % 3);
+  }
+
+  panther_utils::AllocationCounter counter;
+  for (int i = 0; i < iterations; i++) {
+    stamp += period;
+    filter.roll(stamp, 20.0 + i % 3);
+    filter.update(stamp);
+  }
+  EXPECT_LE(counter.count(), filter_roll_budget * iterations);
+}
+
+TEST_F(TestTreeAllocations, LightsTickDischarging)
+{
+  auto tree = factory_.createTree("Lights", create_lights_blackboard());
+  EXPECT_LE(count_tick_allocations(tree), lights_tick_budget * iterations);
+}
+
+TEST_F(TestTreeAllocations, LightsTickCharging)
+{
+  auto bb = create_lights_blackboard();
+  bb->set("battery_status", unsigned(BatteryState::POWER_SUPPLY_STATUS_CHARGING));
+  auto tree = factory_.createTree("Lights", bb);
+  EXPECT_LE(count_tick_allocations(tree), lights_tick_budget * iterations);
+}
+
+TEST_F(TestTreeAllocations, SafetyTick)
+{
+  auto tree = factory_.createTree("Safety", create_safety_blackboard());
+  EXPECT_LE(count_tick_allocations(tree), safety_tick_budget * iterations);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  // TickAfterTimeout reads ROS time
+  ros::Time::init();
+  return RUN_ALL_TESTS();
+}
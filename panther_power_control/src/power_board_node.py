@@ -63,10 +63,28 @@ class PowerBoardNode:
             'SHDN_INIT': False,  # Shutdown Init managed by systemd service
         }
 
+        # lines driven directly by another node, eg. manager_bt_node, are not requested. Their
+        # state is received on hardware/gpio/<line name in lowercase> topics instead
+        external_line_io_state = {
+            'AUX_PW_EN': 'aux_power',
+            'FAN_SW': 'fan',
+        }
+        self._external_lines = rospy.get_param('~external_lines', [])
+        invalid_lines = [
+            name for name in self._external_lines if name not in external_line_io_state.keys()
+        ]
+        if invalid_lines:
+            rospy.logerr(
+                f'[{rospy.get_name()}] Lines can\'t be controlled externally: {invalid_lines}'
+            )
+            rospy.signal_shutdown('Invalid external GPIO lines')
+            return
+
         self._chip = gpiod.Chip('gpiochip0', gpiod.Chip.OPEN_BY_NAME)
         self._lines = {
             name: self._chip.find_line(name)
             for name in list(out_line_names.keys()) + list(in_line_names.keys())
+            if name not in self._external_lines
         }
         not_matched_pins = [name for name, line in self._lines.items() if line is None]
         if not_matched_pins:
@@ -107,9 +125,9 @@ class PowerBoardNode:
         self._e_stop_state_pub.publish(msg)
 
         io_state = IOState()
-        io_state.aux_power = self._lines['AUX_PW_EN'].get_value()
+        io_state.aux_power = self._get_line_value('AUX_PW_EN')
         io_state.charger_connected = not self._lines['CHRG_SENSE'].get_value()
-        io_state.fan = self._lines['FAN_SW'].get_value()
+        io_state.fan = self._get_line_value('FAN_SW')
         io_state.power_button = False
         io_state.digital_power = not self._lines['VDIG_OFF'].get_value()
         io_state.charger_enabled = not self._lines['CHRG_DISABLE'].get_value()
@@ -124,14 +142,26 @@ class PowerBoardNode:
         self._motor_controllers_state_sub = rospy.Subscriber(
             'driver/motor_controllers_state', DriverState, self._motor_controllers_state_cb
         )
+        self._external_line_subs = [
+            rospy.Subscriber(
+                f'hardware/gpio/{name.lower()}',
+                Bool,
+                lambda msg, attribute=external_line_io_state[name]: self._publish_io_state(
+                    attribute, msg.data
+                ),
+            )
+            for name in self._external_lines
+        ]
 
         # -------------------------------
         #   Service Servers
         # -------------------------------
 
-        self._aux_power_enable_server = rospy.Service(
-            'hardware/aux_power_enable', SetBool, self._aux_power_enable_cb
-        )
+        # services of external lines are not advertised, so calls fail instead of being ignored
+        if 'AUX_PW_EN' not in self._external_lines:
+            self._aux_power_enable_server = rospy.Service(
+                'hardware/aux_power_enable', SetBool, self._aux_power_enable_cb
+            )
         self._charger_enable_server = rospy.Service(
             'hardware/charger_enable', SetBool, self._charger_enable_cb
         )
@@ -144,7 +174,10 @@ class PowerBoardNode:
         self._e_stop_trigger_server = rospy.Service(
             'hardware/e_stop_trigger', Trigger, self._e_stop_trigger_cb
         )
-        self._fan_enable_server = rospy.Service('hardware/fan_enable', SetBool, self._fan_enable_cb)
+        if 'FAN_SW' not in self._external_lines:
+            self._fan_enable_server = rospy.Service(
+                'hardware/fan_enable', SetBool, self._fan_enable_cb
+            )
         self._motor_power_enable_server = rospy.Service(
             'hardware/motor_power_enable', SetBool, self._motor_power_enable_cb
         )
@@ -323,6 +356,12 @@ class PowerBoardNode:
 
         return SetBoolResponse(success, msg)
 
+    def _get_line_value(self, name: str) -> bool:
+        # state of external lines is not known until it is received
+        if name in self._external_lines:
+            return False
+        return self._lines[name].get_value()
+
     def _reset_e_stop(self) -> None:
         with self._e_stop_lock:
             self._clearing_e_stop = True
@@ -0,0 +1,59 @@
+#ifndef PANTHER_UTILS_ALLOCATION_COUNTER_HPP_
+#define PANTHER_UTILS_ALLOCATION_COUNTER_HPP_
+
+#include <cstddef>
+
+// replaces malloc, calloc and realloc of glibc with versions counting calls of each thread. The
+// default operator new calls malloc, so allocations made with new are counted too. Meant for tests
+// only and has to be included in exactly one source file of an executable
+
+namespace panther_utils
+{
+
+namespace detail
+{
+inline thread_local std::size_t allocation_count = 0;
+}  // namespace detail
+
+// counts heap allocations made by the calling thread since construction
+class AllocationCounter
+{
+public:
+  AllocationCounter() : start_(detail::allocation_count) {}
+
+  std::size_t count() const { return detail::allocation_count - start_; }
+
+  void reset() { start_ = detail::allocation_count; }
+
+private:
+  std::size_t start_;
+};
+
+}  // namespace panther_utils
+
+extern "C" {
+
+void * __libc_malloc(std::size_t size);
+void * __libc_calloc(std::size_t num, std::size_t size);
+void * __libc_realloc(void * ptr, std::size_t size);
+
+void * malloc(std::size_t size) noexcept
+{
+  panther_utils::detail::allocation_count++;
+  return __libc_malloc(size);
+}
+
+void * calloc(std::size_t num, std::size_t size) noexcept
+{
+  panther_utils::detail::allocation_count++;
+  return __libc_calloc(num, size);
+}
+
+void * realloc(void * ptr, std::size_t size) noexcept
+{
+  panther_utils::detail::allocation_count++;
+  return __libc_realloc(ptr, size);
+}
+}
+
+#endif  // PANTHER_UTILS_ALLOCATION_COUNTER_HPP_
@@ -0,0 +1,326 @@
+#ifndef PANTHER_UTILS_ASYNC_LOGGER_HPP_
+#define PANTHER_UTILS_ASYNC_LOGGER_HPP_
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
+#include <ros/console.h>
+#include <ros/this_node.h>
+
+#include <panther_utils/mpmc_queue.hpp>
+#include <panther_utils/steady_clock.hpp>
+
+namespace panther_utils
+{
+
+// logger deferring formatting and rosconsole calls to a background thread. Logging pushes a
+// fixed-size record with a pointer to the format string, which has to be a string literal, and
+// copies of its arguments into a lock-free queue. String arguments are copied into the record and
+// truncated if they don't fit. Records are dropped if the queue is full.
+class AsyncLogger
+{
+public:
+  using Level = ros::console::levels::Level;
+
+  explicit AsyncLogger(const std::size_t capacity = 256) : queue_(capacity)
+  {
+    thread_ = std::thread(&AsyncLogger::run, this);
+  }
+
+  ~AsyncLogger()
+  {
+    running_.store(false, std::memory_order_release);
+    thread_.join();
+  }
+
+  AsyncLogger(const AsyncLogger &) = delete;
+  AsyncLogger & operator=(const AsyncLogger &) = delete;
+
+  // logger shared by all nodes and plugins of a process
+  static AsyncLogger & instance()
+  {
+    static AsyncLogger logger;
+    return logger;
+  }
+
+  template <typename... Args>
+  void log(const Level level, const double throttle_period, const char * format, const Args &... args)
+  {
+    static_assert(sizeof...(Args) <= max_args_, "Too many log arguments");
+
+    Record record;
+    record.level = level;
+    record.format = format;
+    record.throttle_period = throttle_period;
+    record.num_args = sizeof...(Args);
+    record.text_used = 0;
+    std::size_t i = 0;
+    (set_arg(record, i++, args), ...);
+
+    if (!queue_.try_push(record)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  template <typename... Args>
+  void debug(const char * format, const Args &... args)
+  {
+    log(Level::Debug, 0.0, format, args...);
+  }
+
+  template <typename... Args>
+  void info(const char * format, const Args &... args)
+  {
+    log(Level::Info, 0.0, format, args...);
+  }
+
+  template <typename... Args>
+  void warn(const char * format, const Args &... args)
+  {
+    log(Level::Warn, 0.0, format, args...);
+  }
+
+  template <typename... Args>
+  void error(const char * format, const Args &... args)
+  {
+    log(Level::Error, 0.0, format, args...);
+  }
+
+  // messages are throttled per format string and value of string arguments
+  template <typename... Args>
+  void warn_throttle(const double period, const char * format, const Args &... args)
+  {
+    log(Level::Warn, period, format, args...);
+  }
+
+  template <typename... Args>
+  void error_throttle(const double period, const char * format, const Args &... args)
+  {
+    log(Level::Error, period, format, args...);
+  }
+
+  std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr std::size_t max_args_ = 4;
+  static constexpr std::size_t text_size_ = 192;
+  static constexpr std::size_t max_message_size_ = 1024;
+
+  enum class ArgType : std::uint8_t { SIGNED, UNSIGNED, FLOATING, STRING };
+
+  struct Arg
+  {
+    ArgType type;
+    union {
+      long long i;
+      unsigned long long u;
+      double d;
+      std::uint16_t text_offset;
+    };
+  };
+
+  struct Record
+  {
+    Level level;
+    const char * format;
+    double throttle_period;
+    std::uint8_t num_args;
+    std::uint16_t text_used;
+    std::array<Arg, max_args_> args;
+    std::array<char, text_size_> text;
+  };
+
+  template <typename T>
+  static void set_arg(Record & record, const std::size_t i, const T & value)
+  {
+    auto & arg = record.args[i];
+    if constexpr (std::is_same_v<std::decay_t<T>, std::string>) {
+      set_string_arg(record, arg, value.c_str(), value.size());
+    } else if constexpr (std::is_convertible_v<T, const char *>) {
+      const char * str = value;
+      set_string_arg(record, arg, str ? str : "(null)", str ? std::strlen(str) : 6);
+    } else if constexpr (std::is_floating_point_v<T>) {
+      arg.type = ArgType::FLOATING;
+      arg.d = value;
+    } else if constexpr (std::is_enum_v<T>) {
+      arg.type = ArgType::SIGNED;
+      arg.i = static_cast<long long>(value);
+    } else if constexpr (std::is_signed_v<T>) {
+      arg.type = ArgType::SIGNED;
+      arg.i = value;
+    } else {
+      static_assert(std::is_integral_v<T>, "Unsupported log argument type");
+      arg.type = ArgType::UNSIGNED;
+      arg.u = value;
+    }
+  }
+
+  static void set_string_arg(Record & record, Arg & arg, const char * str, const std::size_t size)
+  {
+    const std::size_t offset = record.text_used;
+    const std::size_t length = std::min(size, text_size_ - offset - 1);
+    std::memcpy(record.text.data() + offset, str, length);
+    record.text[offset + length] = '\0';
+
+    arg.type = ArgType::STRING;
+    arg.text_offset = static_cast<std::uint16_t>(offset);
+    record.text_used = static_cast<std::uint16_t>(std::min(offset + length + 1, text_size_ - 1));
+  }
+
+  void run()
+  {
+    // logging must never compete with real-time threads it may have been created from
+    sched_param param{};
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+
+    Record record;
+    while (true) {
+      const bool running = running_.load(std::memory_order_acquire);
+      bool popped = false;
+      while (queue_.try_pop(record)) {
+        popped = true;
+        process(record);
+      }
+      if (!running) {
+        break;
+      }
+      if (!popped) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    }
+  }
+
+  void process(const Record & record)
+  {
+    if (record.throttle_period > 0.0) {
+      const auto key = throttle_key(record);
+      const auto now = steady_now_ns();
+      const auto period = static_cast<std::uint64_t>(record.throttle_period * 1e9);
+      const auto it = last_logged_.find(key);
+      if (it != last_logged_.end() && now - it->second < period) {
+        return;
+      }
+      last_logged_[key] = now;
+    }
+
+    format(record);
+    ROS_LOG(record.level, ROSCONSOLE_DEFAULT_NAME, "[%s] %s", node_name().c_str(), message_);
+  }
+
+  std::size_t throttle_key(const Record & record) const
+  {
+    auto key = std::hash<const char *>{}(record.format);
+    for (std::size_t i = 0; i < record.num_args; i++) {
+      if (record.args[i].type == ArgType::STRING) {
+        key ^= std::hash<std::string>{}(record.text.data() + record.args[i].text_offset) +
+               0x9e3779b9 + (key << 6) + (key >> 2);
+      }
+    }
+    return key;
+  }
+
+  // formats conversion specifications one by one, adjusting length modifier and conversion to
+  // the type of recorded argument
+  void format(const Record & record)
+  {
+    const char * f = record.format;
+    std::size_t pos = 0;
+    std::size_t arg_idx = 0;
+
+    while (*f && pos < max_message_size_ - 1) {
+      if (*f != '%') {
+        message_[pos++] = *f++;
+        continue;
+      }
+      if (f[1] == '%') {
+        message_[pos++] = '%';
+        f += 2;
+        continue;
+      }
+
+      std::array<char, 32> spec;
+      std::size_t spec_len = 0;
+      spec[spec_len++] = *f++;
+      while (*f && std::strchr("-+ #0123456789.*", *f) && spec_len < spec.size() - 4) {
+        spec[spec_len++] = *f++;
+      }
+      while (*f && std::strchr("hlLqjzt", *f)) {
+        f++;
+      }
+      const char conversion = *f ? *f++ : 's';
+
+      if (arg_idx >= record.num_args) {
+        break;
+      }
+      const auto & arg = record.args[arg_idx++];
+      char * out = message_ + pos;
+      const std::size_t out_size = max_message_size_ - pos;
+      int written = 0;
+
+      switch (arg.type) {
+        case ArgType::STRING:
+          spec[spec_len++] = 's';
+          spec[spec_len] = '\0';
+          written = std::snprintf(out, out_size, spec.data(), record.text.data() + arg.text_offset);
+          break;
+        case ArgType::FLOATING:
+          spec[spec_len++] = std::strchr("fFeEgGaA", conversion) ? conversion : 'f';
+          spec[spec_len] = '\0';
+          written = std::snprintf(out, out_size, spec.data(), arg.d);
+          break;
+        case ArgType::SIGNED:
+        case ArgType::UNSIGNED:
+          spec[spec_len++] = 'l';
+          spec[spec_len++] = 'l';
+          if (std::strchr("uxXo", conversion)) {
+            spec[spec_len++] = conversion;
+            spec[spec_len] = '\0';
+            written = std::snprintf(out, out_size, spec.data(), arg.u);
+          } else {
+            spec[spec_len++] = 'd';
+            spec[spec_len] = '\0';
+            written = std::snprintf(out, out_size, spec.data(), arg.i);
+          }
+          break;
+      }
+
+      if (written > 0) {
+        pos = std::min(pos + static_cast<std::size_t>(written), max_message_size_ - 1);
+      }
+    }
+    message_[pos] = '\0';
+  }
+
+  static const std::string & node_name()
+  {
+    static const std::string name = ros::this_node::getName();
+    return name;
+  }
+
+  MPMCQueue<Record> queue_;
+  std::atomic_bool running_{true};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::thread thread_;
+
+  // used only by background thread
+  std::unordered_map<std::size_t, std::uint64_t> last_logged_;
+  char message_[max_message_size_];
+};
+
+}  // namespace panther_utils
+
+#endif  // PANTHER_UTILS_ASYNC_LOGGER_HPP_
@@ -0,0 +1,107 @@
+#ifndef PANTHER_UTILS_HISTOGRAM_HPP_
+#define PANTHER_UTILS_HISTOGRAM_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace panther_utils
+{
+
+// lock-free log-linear histogram of unsigned values (eg. latencies in ns), values are recorded
+// with relative error below 1/16 and recording is safe from any number of threads
+class Histogram
+{
+public:
+  Histogram() { reset(); }
+
+  Histogram(const Histogram &) = delete;
+  Histogram & operator=(const Histogram &) = delete;
+
+  void record(const std::uint64_t value)
+  {
+    buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    auto max = max_.load(std::memory_order_relaxed);
+    while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  // not synchronized with concurrent calls to record
+  void reset()
+  {
+    for (auto & bucket : buckets_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+  }
+
+  std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  std::uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+  double mean() const
+  {
+    const auto count = this->count();
+    return count ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / count : 0.0;
+  }
+
+  // returns upper bound of the bucket containing given percentile in range [0, 100]
+  std::uint64_t percentile(const double percentile) const
+  {
+    const auto count = this->count();
+    if (count == 0) {
+      return 0;
+    }
+
+    const auto rank = static_cast<std::uint64_t>(percentile / 100.0 * (count - 1)) + 1;
+    std::uint64_t accumulated = 0;
+    for (std::size_t i = 0; i < buckets_.size(); i++) {
+      accumulated += buckets_[i].load(std::memory_order_relaxed);
+      if (accumulated >= rank) {
+        const auto upper_bound = bucket_upper_bound(i);
+        return upper_bound < max() ? upper_bound : max();
+      }
+    }
+    return max();
+  }
+
+private:
+  static constexpr unsigned sub_bucket_bits_ = 4;
+  static constexpr std::size_t sub_bucket_count_ = 1 << sub_bucket_bits_;
+
+  std::array<std::atomic<std::uint64_t>, 64 * sub_bucket_count_> buckets_;
+  std::atomic<std::uint64_t> count_;
+  std::atomic<std::uint64_t> sum_;
+  std::atomic<std::uint64_t> max_;
+
+  // values below 2 * sub_bucket_count_ have own buckets, larger values are grouped by their most
+  // significant bit and split into sub_bucket_count_ linear buckets
+  static std::size_t bucket_index(const std::uint64_t value)
+  {
+    if (value < 2 * sub_bucket_count_) {
+      return value;
+    }
+    const unsigned msb = 63 - __builtin_clzll(value);
+    const unsigned shift = msb - sub_bucket_bits_;
+    return shift * sub_bucket_count_ + (value >> shift);
+  }
+
+  static std::uint64_t bucket_upper_bound(const std::size_t index)
+  {
+    if (index < 2 * sub_bucket_count_) {
+      return index;
+    }
+    const unsigned shift = index / sub_bucket_count_ - 1;
+    const std::uint64_t mantissa = index - shift * sub_bucket_count_;
+    return ((mantissa + 1) << shift) - 1;
+  }
+};
+
+}  // namespace panther_utils
+
+#endif  // PANTHER_UTILS_HISTOGRAM_HPP_
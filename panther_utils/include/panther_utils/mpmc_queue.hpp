@@ -0,0 +1,100 @@
+#ifndef PANTHER_UTILS_MPMC_QUEUE_HPP_
+#define PANTHER_UTILS_MPMC_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace panther_utils
+{
+
+// bounded lock-free queue safe for any number of producer and consumer threads, based on
+// Dmitry Vyukov's bounded MPMC queue. Capacity has to be a power of two.
+template <typename T>
+class MPMCQueue
+{
+public:
+  explicit MPMCQueue(const std::size_t capacity)
+  : mask_(capacity - 1), buffer_(std::make_unique<Cell[]>(capacity))
+  {
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+      throw std::invalid_argument("Queue capacity has to be a power of two");
+    }
+    for (std::size_t i = 0; i < capacity; i++) {
+      buffer_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MPMCQueue(const MPMCQueue &) = delete;
+  MPMCQueue & operator=(const MPMCQueue &) = delete;
+
+  // returns false if queue is full
+  bool try_push(const T & value)
+  {
+    Cell * cell;
+    auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &buffer_[pos & mask_];
+      const auto seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // returns false if queue is empty
+  bool try_pop(T & value)
+  {
+    Cell * cell;
+    auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &buffer_[pos & mask_];
+      const auto seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    value = cell->data;
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  std::size_t capacity() const { return mask_ + 1; }
+
+private:
+  static constexpr std::size_t cache_line_size_ = 64;
+
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence;
+    T data;
+  };
+
+  const std::size_t mask_;
+  std::unique_ptr<Cell[]> buffer_;
+  alignas(cache_line_size_) std::atomic<std::size_t> enqueue_pos_{0};
+  alignas(cache_line_size_) std::atomic<std::size_t> dequeue_pos_{0};
+};
+
+}  // namespace panther_utils
+
+#endif  // PANTHER_UTILS_MPMC_QUEUE_HPP_
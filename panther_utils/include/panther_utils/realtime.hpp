@@ -0,0 +1,178 @@
+#ifndef PANTHER_UTILS_REALTIME_HPP_
+#define PANTHER_UTILS_REALTIME_HPP_
+
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ros/ros.h>
+
+namespace panther_utils
+{
+
+struct ThreadRealtimeConfig
+{
+  std::string policy = "other";
+  int priority = 0;
+  std::vector<int> cpus;
+};
+
+// applies real-time settings read from ~realtime/ namespace of given node handle. Process settings
+// are applied with configure_process() and per thread settings with configure_thread(role), which
+// reads ~realtime/<role>/ namespace. Every applied setting and failure is logged at startup.
+// Nothing is changed if ~realtime/enabled is false.
+class RealtimeConfigurator
+{
+public:
+  explicit RealtimeConfigurator(const ros::NodeHandle & ph) : ph_(ph)
+  {
+    node_name_ = ros::this_node::getName();
+    enabled_ = ph_.param<bool>("realtime/enabled", false);
+    lock_memory_ = ph_.param<bool>("realtime/lock_memory", true);
+    prefault_heap_size_ = ph_.param<int>("realtime/prefault_heap_size", 8 * 1024 * 1024);
+    prefault_stack_size_ = ph_.param<int>("realtime/prefault_stack_size", 256 * 1024);
+  }
+
+  bool enabled() const { return enabled_; }
+
+  ThreadRealtimeConfig thread_config(const std::string & role) const
+  {
+    ThreadRealtimeConfig config;
+    config.policy = ph_.param<std::string>("realtime/" + role + "/policy", config.policy);
+    config.priority = ph_.param<int>("realtime/" + role + "/priority", config.priority);
+    config.cpus = ph_.param<std::vector<int>>("realtime/" + role + "/cpus", config.cpus);
+    return config;
+  }
+
+  // has to be called before any thread that should use prefaulted heap is created
+  void configure_process() const
+  {
+    if (!enabled_) {
+      ROS_INFO("[%s] Real-time configuration disabled", node_name_.c_str());
+      return;
+    }
+
+    if (lock_memory_) {
+      // keep freed memory in process so it stays locked and prefaulted
+      mallopt(M_TRIM_THRESHOLD, -1);
+      mallopt(M_MMAP_MAX, 0);
+
+      if (mlockall(MCL_CURRENT | MCL_FUTURE)) {
+        ROS_WARN("[%s] Real-time: failed to lock memory: %s", node_name_.c_str(), strerror(errno));
+      } else {
+        ROS_INFO("[%s] Real-time: locked process memory", node_name_.c_str());
+      }
+    }
+
+    if (prefault_heap_size_ > 0) {
+      auto heap = static_cast<volatile char *>(std::malloc(prefault_heap_size_));
+      if (heap) {
+        for (int i = 0; i < prefault_heap_size_; i += page_size()) {
+          heap[i] = 0;
+        }
+        std::free(const_cast<char *>(heap));
+        ROS_INFO(
+          "[%s] Real-time: prefaulted %d bytes of heap", node_name_.c_str(), prefault_heap_size_);
+      } else {
+        ROS_WARN("[%s] Real-time: failed to prefault heap", node_name_.c_str());
+      }
+    }
+  }
+
+  // configures calling thread, threads created by it inherit scheduling policy and affinity
+  void configure_thread(const std::string & role) const
+  {
+    if (!enabled_) {
+      return;
+    }
+
+    const auto config = thread_config(role);
+    const auto thread = pthread_self();
+
+    int policy;
+    if (config.policy == "other") {
+      policy = SCHED_OTHER;
+    } else if (config.policy == "fifo") {
+      policy = SCHED_FIFO;
+    } else if (config.policy == "rr") {
+      policy = SCHED_RR;
+    } else {
+      throw std::invalid_argument(
+        "Invalid scheduling policy '" + config.policy + "' of '" + role +
+        "' thread. Valid policies are: other, fifo, rr");
+    }
+
+    sched_param param{};
+    param.sched_priority = policy == SCHED_OTHER ? 0 : config.priority;
+    const auto sched_ret = pthread_setschedparam(thread, policy, &param);
+    if (sched_ret) {
+      ROS_WARN(
+        "[%s] Real-time: failed to set '%s' thread policy %s with priority %d: %s",
+        node_name_.c_str(), role.c_str(), config.policy.c_str(), param.sched_priority,
+        strerror(sched_ret));
+    } else {
+      ROS_INFO(
+        "[%s] Real-time: '%s' thread uses policy %s with priority %d", node_name_.c_str(),
+        role.c_str(), config.policy.c_str(), param.sched_priority);
+    }
+
+    if (!config.cpus.empty()) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      std::string cpus;
+      for (const auto cpu : config.cpus) {
+        CPU_SET(cpu, &cpu_set);
+        cpus += (cpus.empty() ? "" : ", ") + std::to_string(cpu);
+      }
+
+      const auto affinity_ret = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+      if (affinity_ret) {
+        ROS_WARN(
+          "[%s] Real-time: failed to pin '%s' thread to CPUs [%s]: %s", node_name_.c_str(),
+          role.c_str(), cpus.c_str(), strerror(affinity_ret));
+      } else {
+        ROS_INFO(
+          "[%s] Real-time: '%s' thread pinned to CPUs [%s]", node_name_.c_str(), role.c_str(),
+          cpus.c_str());
+      }
+    }
+
+    if (prefault_stack_size_ > 0) {
+      prefault_stack(prefault_stack_size_);
+    }
+  }
+
+private:
+  bool enabled_;
+  bool lock_memory_;
+  int prefault_heap_size_;
+  int prefault_stack_size_;
+  std::string node_name_;
+  ros::NodeHandle ph_;
+
+  static int page_size() { return static_cast<int>(sysconf(_SC_PAGESIZE)); }
+
+  // touch stack pages of calling thread so they are mapped (and locked) before they are needed
+  static void prefault_stack(const int size)
+  {
+    auto stack = static_cast<volatile char *>(alloca(size));
+    for (int i = 0; i < size; i += page_size()) {
+      stack[i] = 0;
+    }
+  }
+};
+
+}  // namespace panther_utils
+
+#endif  // PANTHER_UTILS_REALTIME_HPP_
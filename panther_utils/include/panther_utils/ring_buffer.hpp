@@ -0,0 +1,86 @@
+#ifndef PANTHER_UTILS_RING_BUFFER_HPP_
+#define PANTHER_UTILS_RING_BUFFER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace panther_utils
+{
+
+// fixed capacity buffer overwriting the oldest element when full, storage is allocated only once
+template <typename T>
+class RingBuffer
+{
+public:
+  explicit RingBuffer(const std::size_t capacity) : data_(capacity)
+  {
+    if (capacity == 0) {
+      throw std::invalid_argument("Ring buffer capacity has to be greater than 0");
+    }
+  }
+
+  RingBuffer(const std::size_t capacity, const T & initial_value) : RingBuffer(capacity)
+  {
+    fill(initial_value);
+  }
+
+  // adds value at the back, returns false if the oldest value had to be overwritten
+  bool push(const T & value)
+  {
+    const bool was_full = full();
+    data_[(head_ + size_) % data_.size()] = value;
+    if (was_full) {
+      head_ = (head_ + 1) % data_.size();
+    } else {
+      size_++;
+    }
+    return !was_full;
+  }
+
+  void pop()
+  {
+    if (empty()) {
+      throw std::out_of_range("Pop from empty ring buffer");
+    }
+    head_ = (head_ + 1) % data_.size();
+    size_--;
+  }
+
+  void fill(const T & value)
+  {
+    std::fill(data_.begin(), data_.end(), value);
+    head_ = 0;
+    size_ = data_.size();
+  }
+
+  void clear()
+  {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  // index 0 is the oldest element
+  const T & operator[](const std::size_t index) const
+  {
+    return data_[(head_ + index) % data_.size()];
+  }
+
+  const T & front() const { return (*this)[0]; }
+  const T & back() const { return (*this)[size_ - 1]; }
+
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return data_.size(); }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == data_.size(); }
+
+private:
+  std::vector<T> data_;
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+};
+
+}  // namespace panther_utils
+
+#endif  // PANTHER_UTILS_RING_BUFFER_HPP_
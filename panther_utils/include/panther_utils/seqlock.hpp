@@ -0,0 +1,59 @@
+#ifndef PANTHER_UTILS_SEQLOCK_HPP_
+#define PANTHER_UTILS_SEQLOCK_HPP_
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+namespace panther_utils
+{
+
+// latest value slot with a single writer and many readers, readers never block the writer
+template <typename T>
+class SeqLock
+{
+  static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires trivially copyable type");
+
+public:
+  SeqLock() = default;
+  explicit SeqLock(const T & value) { std::memcpy(&value_, &value, sizeof(T)); }
+
+  SeqLock(const SeqLock &) = delete;
+  SeqLock & operator=(const SeqLock &) = delete;
+
+  // called only by writer thread
+  void store(const T & value)
+  {
+    const auto seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&value_, &value, sizeof(T));
+    seq_.store(seq + 2, std::memory_order_release);
+  }
+
+  T load() const
+  {
+    T value;
+    unsigned seq_begin;
+    unsigned seq_end;
+    do {
+      seq_begin = seq_.load(std::memory_order_acquire);
+      std::memcpy(&value, &value_, sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      seq_end = seq_.load(std::memory_order_relaxed);
+      // odd sequence means that write is in progress
+    } while ((seq_begin & 1) || seq_begin != seq_end);
+    return value;
+  }
+
+  // number of stores, can be used by readers to detect new values
+  unsigned version() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+  std::atomic<unsigned> seq_{0};
+  T value_{};
+};
+
+}  // namespace panther_utils
+
+#endif  // PANTHER_UTILS_SEQLOCK_HPP_
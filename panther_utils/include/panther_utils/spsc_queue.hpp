@@ -0,0 +1,72 @@
+#ifndef PANTHER_UTILS_SPSC_QUEUE_HPP_
+#define PANTHER_UTILS_SPSC_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace panther_utils
+{
+
+// bounded lock-free queue for exactly one producer thread and one consumer thread
+template <typename T>
+class SPSCQueue
+{
+public:
+  explicit SPSCQueue(const std::size_t capacity) : data_(capacity + 1)
+  {
+    if (capacity == 0) {
+      throw std::invalid_argument("Queue capacity has to be greater than 0");
+    }
+  }
+
+  SPSCQueue(const SPSCQueue &) = delete;
+  SPSCQueue & operator=(const SPSCQueue &) = delete;
+
+  // called only by producer, returns false if queue is full
+  bool try_push(const T & value)
+  {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto next_tail = increment(tail);
+    if (next_tail == head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    data_[tail] = value;
+    tail_.store(next_tail, std::memory_order_release);
+    return true;
+  }
+
+  // called only by consumer, returns false if queue is empty
+  bool try_pop(T & value)
+  {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = data_[head];
+    head_.store(increment(head), std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const
+  {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+  std::size_t capacity() const { return data_.size() - 1; }
+
+private:
+  // keep indices on separate cache lines to avoid false sharing between threads
+  static constexpr std::size_t cache_line_size_ = 64;
+
+  std::vector<T> data_;
+  alignas(cache_line_size_) std::atomic<std::size_t> head_{0};
+  alignas(cache_line_size_) std::atomic<std::size_t> tail_{0};
+
+  std::size_t increment(const std::size_t index) const { return (index + 1) % data_.size(); }
+};
+
+}  // namespace panther_utils
+
+#endif  // PANTHER_UTILS_SPSC_QUEUE_HPP_
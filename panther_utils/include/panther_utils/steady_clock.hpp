@@ -0,0 +1,41 @@
+#ifndef PANTHER_UTILS_STEADY_CLOCK_HPP_
+#define PANTHER_UTILS_STEADY_CLOCK_HPP_
+
+#include <chrono>
+#include <cstdint>
+
+namespace panther_utils
+{
+
+using SteadyClock = std::chrono::steady_clock;
+
+// monotonic time in nanoseconds, unaffected by ROS time and system clock changes
+inline std::int64_t steady_now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           SteadyClock::now().time_since_epoch())
+    .count();
+}
+
+class Stopwatch
+{
+public:
+  Stopwatch() : start_(SteadyClock::now()) {}
+
+  void reset() { start_ = SteadyClock::now(); }
+
+  std::int64_t elapsed_ns() const
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - start_)
+      .count();
+  }
+
+  double elapsed_sec() const { return static_cast<double>(elapsed_ns()) * 1e-9; }
+
+private:
+  SteadyClock::time_point start_;
+};
+
+}  // namespace panther_utils
+
+#endif  // PANTHER_UTILS_STEADY_CLOCK_HPP_
@@ -0,0 +1,26 @@
+#ifndef PANTHER_UTILS_TRACEPOINTS_HPP_
+#define PANTHER_UTILS_TRACEPOINTS_HPP_
+
+// USDT static tracepoints of the "panther" provider. Each tracepoint compiles to a single nop and
+// a note in the binary. Arguments are evaluated on every pass, whether a tracer is attached or
+// not, so only pass values that are already at hand, e.g. members or c_str() of existing strings,
+// never ones that have to be computed or allocated. Without <sys/sdt.h> (systemtap-sdt-dev
+// package) or with PANTHER_DISABLE_TRACEPOINTS defined, tracepoints compile to nothing. List them
+// with: bpftrace -l 'usdt:<binary>:panther:*'
+
+#if !defined(PANTHER_DISABLE_TRACEPOINTS) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define PANTHER_TRACEPOINTS_ENABLED 1
+#endif
+#endif
+
+#ifdef PANTHER_TRACEPOINTS_ENABLED
+#define PANTHER_TRACEPOINT(name, ...) STAP_PROBEV(panther, name, ##__VA_ARGS__)
+#else
+#define PANTHER_TRACEPOINT(name, ...) \
+  do {                                \
+  } while (0)
+#endif
+
+#endif  // PANTHER_UTILS_TRACEPOINTS_HPP_
@@ -0,0 +1,76 @@
+// single-threaded microbenchmarks of hot path operations, prints average time per operation
+
+#include <cstdint>
+#include <cstdio>
+
+#include <panther_utils/histogram.hpp>
+#include <panther_utils/mpmc_queue.hpp>
+#include <panther_utils/ring_buffer.hpp>
+#include <panther_utils/seqlock.hpp>
+#include <panther_utils/spsc_queue.hpp>
+#include <panther_utils/steady_clock.hpp>
+
+namespace
+{
+
+constexpr std::uint64_t iterations = 10000000;
+
+// keeps results alive, so the compiler doesn't remove benchmarked code
+volatile std::uint64_t sink;
+
+template <typename F>
+void run(const char * name, F && f)
+{
+  // warm up caches and branch predictors
+  for (std::uint64_t i = 0; i < iterations / 10; i++) {
+    f(i);
+  }
+
+  panther_utils::Stopwatch stopwatch;
+  for (std::uint64_t i = 0; i < iterations; i++) {
+    f(i);
+  }
+  std::printf("%-28s %8.2f ns/op\n", name, double(stopwatch.elapsed_ns()) / iterations);
+}
+
+struct Sample
+{
+  double values[4];
+};
+
+}  // namespace
+
+int main()
+{
+  panther_utils::RingBuffer<double> ring_buffer(64);
+  run("RingBuffer::push", [&](std::uint64_t i) { ring_buffer.push(double(i)); });
+  sink = std::uint64_t(ring_buffer.back());
+
+  panther_utils::SeqLock<Sample> seqlock;
+  run("SeqLock::store", [&](std::uint64_t i) { seqlock.store({{double(i), 0.0, 0.0, 0.0}}); });
+  run("SeqLock::load", [&](std::uint64_t) { sink = std::uint64_t(seqlock.load().values[0]); });
+
+  panther_utils::Histogram histogram;
+  run("Histogram::record", [&](std::uint64_t i) { histogram.record(i); });
+  sink = histogram.count();
+
+  panther_utils::MPMCQueue<std::uint64_t> queue(64);
+  run("MPMCQueue::try_push+try_pop", [&](std::uint64_t i) {
+    std::uint64_t value = 0;
+    queue.try_push(i);
+    queue.try_pop(value);
+    sink = value;
+  });
+
+  panther_utils::SPSCQueue<std::uint64_t> spsc_queue(64);
+  run("SPSCQueue::try_push+try_pop", [&](std::uint64_t i) {
+    std::uint64_t value = 0;
+    spsc_queue.try_push(i);
+    spsc_queue.try_pop(value);
+    sink = value;
+  });
+
+  run("steady_now_ns", [&](std::uint64_t) { sink = panther_utils::steady_now_ns(); });
+
+  return 0;
+}
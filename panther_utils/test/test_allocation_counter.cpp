@@ -0,0 +1,58 @@
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <panther_utils/allocation_counter.hpp>
+#include <panther_utils/ring_buffer.hpp>
+
+TEST(TestAllocationCounter, CountsNewAndMalloc)
+{
+  panther_utils::AllocationCounter counter;
+  auto value = std::make_unique<int>(1);
+  void * ptr = std::malloc(16);
+  std::free(ptr);
+  EXPECT_EQ(counter.count(), 2u);
+
+  counter.reset();
+  std::vector<int> vector;
+  vector.reserve(16);
+  EXPECT_EQ(counter.count(), 1u);
+}
+
+TEST(TestAllocationCounter, IgnoresOtherThreads)
+{
+  panther_utils::AllocationCounter counter;
+  std::thread thread([] {
+    for (int i = 0; i < 100; i++) {
+      auto value = std::make_unique<std::string>(64, 'x');
+    }
+  });
+  // thread creation allocates its state in the calling thread
+  const auto after_start = counter.count();
+  thread.join();
+  EXPECT_EQ(counter.count(), after_start);
+}
+
+TEST(TestAllocationCounter, RingBufferDoesNotAllocate)
+{
+  panther_utils::RingBuffer<int> buffer(8);
+
+  panther_utils::AllocationCounter counter;
+  for (int i = 0; i < 100; i++) {
+    buffer.push(i);
+    if (buffer.full()) {
+      buffer.pop();
+    }
+  }
+  EXPECT_EQ(counter.count(), 0u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
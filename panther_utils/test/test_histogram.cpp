@@ -0,0 +1,87 @@
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <panther_utils/histogram.hpp>
+
+TEST(TestHistogram, Empty)
+{
+  panther_utils::Histogram histogram;
+  EXPECT_EQ(histogram.count(), 0u);
+  EXPECT_EQ(histogram.max(), 0u);
+  EXPECT_EQ(histogram.mean(), 0.0);
+  EXPECT_EQ(histogram.percentile(50.0), 0u);
+}
+
+TEST(TestHistogram, SmallValuesAreExact)
+{
+  panther_utils::Histogram histogram;
+  for (std::uint64_t i = 0; i < 32; i++) {
+    histogram.record(i);
+  }
+  EXPECT_EQ(histogram.count(), 32u);
+  EXPECT_EQ(histogram.max(), 31u);
+  EXPECT_DOUBLE_EQ(histogram.mean(), 15.5);
+  EXPECT_EQ(histogram.percentile(0.0), 0u);
+  EXPECT_EQ(histogram.percentile(100.0), 31u);
+}
+
+TEST(TestHistogram, PercentileRelativeError)
+{
+  panther_utils::Histogram histogram;
+  for (std::uint64_t i = 1; i <= 100000; i++) {
+    histogram.record(i * 1000);
+  }
+
+  for (const double percentile : {1.0, 10.0, 50.0, 90.0, 99.0, 99.9}) {
+    const double expected = percentile / 100.0 * 1e8;
+    const double value = histogram.percentile(percentile);
+    EXPECT_GE(value, expected * (1.0 - 1.0 / 16.0)) << "percentile " << percentile;
+    EXPECT_LE(value, expected * (1.0 + 1.0 / 16.0)) << "percentile " << percentile;
+  }
+  EXPECT_EQ(histogram.percentile(100.0), 100000000u);
+}
+
+TEST(TestHistogram, LargeValues)
+{
+  panther_utils::Histogram histogram;
+  const std::uint64_t value = std::uint64_t(1) << 62;
+  histogram.record(value);
+  EXPECT_EQ(histogram.max(), value);
+  EXPECT_EQ(histogram.percentile(50.0), value);
+}
+
+TEST(TestHistogram, Reset)
+{
+  panther_utils::Histogram histogram;
+  histogram.record(100);
+  histogram.reset();
+  EXPECT_EQ(histogram.count(), 0u);
+  EXPECT_EQ(histogram.max(), 0u);
+}
+
+TEST(TestHistogram, ConcurrentRecord)
+{
+  panther_utils::Histogram histogram;
+  std::vector<std::thread> threads;
+  for (std::uint64_t t = 0; t < 4; t++) {
+    threads.emplace_back([&histogram, t]() {
+      for (std::uint64_t i = 0; i < 100000; i++) {
+        histogram.record(t * 100000 + i);
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(histogram.count(), 400000u);
+  EXPECT_EQ(histogram.max(), 399999u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,74 @@
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <panther_utils/mpmc_queue.hpp>
+
+TEST(TestMPMCQueue, CapacityNotPowerOfTwoThrows)
+{
+  EXPECT_THROW(panther_utils::MPMCQueue<int>(3), std::invalid_argument);
+}
+
+TEST(TestMPMCQueue, FifoOrder)
+{
+  panther_utils::MPMCQueue<int> queue(4);
+  int value;
+  EXPECT_FALSE(queue.try_pop(value));
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(queue.try_push(i));
+  }
+  EXPECT_FALSE(queue.try_push(4));
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(TestMPMCQueue, ConcurrentProducersConsumers)
+{
+  constexpr std::uint64_t items_per_producer = 100000;
+  constexpr int threads_count = 3;
+
+  panther_utils::MPMCQueue<std::uint64_t> queue(64);
+  std::atomic<std::uint64_t> popped_count{0};
+  std::atomic<std::uint64_t> popped_sum{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threads_count; t++) {
+    threads.emplace_back([&queue]() {
+      for (std::uint64_t i = 1; i <= items_per_producer; i++) {
+        while (!queue.try_push(i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    threads.emplace_back([&]() {
+      std::uint64_t value;
+      while (popped_count.load() < threads_count * items_per_producer) {
+        if (queue.try_pop(value)) {
+          popped_sum += value;
+          popped_count++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(popped_count.load(), threads_count * items_per_producer);
+  EXPECT_EQ(popped_sum.load(), threads_count * items_per_producer * (items_per_producer + 1) / 2);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,68 @@
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <panther_utils/ring_buffer.hpp>
+
+TEST(TestRingBuffer, ZeroCapacityThrows)
+{
+  EXPECT_THROW(panther_utils::RingBuffer<int>(0), std::invalid_argument);
+}
+
+TEST(TestRingBuffer, PushUntilFull)
+{
+  panther_utils::RingBuffer<int> buffer(3);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_TRUE(buffer.push(1));
+  EXPECT_TRUE(buffer.push(2));
+  EXPECT_TRUE(buffer.push(3));
+  EXPECT_TRUE(buffer.full());
+  EXPECT_EQ(buffer.size(), 3u);
+  EXPECT_EQ(buffer.front(), 1);
+  EXPECT_EQ(buffer.back(), 3);
+}
+
+TEST(TestRingBuffer, PushOverwritesOldest)
+{
+  panther_utils::RingBuffer<int> buffer(3);
+  for (int i = 1; i <= 3; i++) {
+    buffer.push(i);
+  }
+  EXPECT_FALSE(buffer.push(4));
+  EXPECT_FALSE(buffer.push(5));
+  EXPECT_EQ(buffer.size(), 3u);
+  EXPECT_EQ(buffer[0], 3);
+  EXPECT_EQ(buffer[1], 4);
+  EXPECT_EQ(buffer[2], 5);
+}
+
+TEST(TestRingBuffer, PopRemovesOldest)
+{
+  panther_utils::RingBuffer<int> buffer(2);
+  buffer.push(1);
+  buffer.push(2);
+  buffer.pop();
+  EXPECT_EQ(buffer.size(), 1u);
+  EXPECT_EQ(buffer.front(), 2);
+  buffer.pop();
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_THROW(buffer.pop(), std::out_of_range);
+}
+
+TEST(TestRingBuffer, FillAndClear)
+{
+  panther_utils::RingBuffer<int> buffer(4, 7);
+  EXPECT_TRUE(buffer.full());
+  for (std::size_t i = 0; i < buffer.size(); i++) {
+    EXPECT_EQ(buffer[i], 7);
+  }
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.capacity(), 4u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,72 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <panther_utils/seqlock.hpp>
+
+namespace
+{
+
+struct Sample
+{
+  std::uint64_t a;
+  std::uint64_t b;
+  std::uint64_t c;
+};
+
+}  // namespace
+
+TEST(TestSeqLock, StoreLoad)
+{
+  panther_utils::SeqLock<Sample> slot({1, 2, 3});
+  EXPECT_EQ(slot.version(), 0u);
+  EXPECT_EQ(slot.load().b, 2u);
+
+  slot.store({4, 5, 6});
+  EXPECT_EQ(slot.version(), 1u);
+  const auto value = slot.load();
+  EXPECT_EQ(value.a, 4u);
+  EXPECT_EQ(value.b, 5u);
+  EXPECT_EQ(value.c, 6u);
+}
+
+TEST(TestSeqLock, ReadersNeverSeeTornValues)
+{
+  panther_utils::SeqLock<Sample> slot({0, 0, 0});
+  std::atomic_bool running{true};
+  std::atomic<std::uint64_t> torn{0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; i++) {
+    readers.emplace_back([&]() {
+      std::uint64_t last = 0;
+      while (running.load(std::memory_order_relaxed)) {
+        const auto value = slot.load();
+        if (value.a != value.b || value.b != value.c || value.a < last) {
+          torn++;
+        }
+        last = value.a;
+      }
+    });
+  }
+
+  for (std::uint64_t i = 1; i <= 200000; i++) {
+    slot.store({i, i, i});
+  }
+  running = false;
+  for (auto & reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(torn.load(), 0u);
+  EXPECT_EQ(slot.load().a, 200000u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <panther_utils/spsc_queue.hpp>
+
+TEST(TestSPSCQueue, ZeroCapacityThrows)
+{
+  EXPECT_THROW(panther_utils::SPSCQueue<int>(0), std::invalid_argument);
+}
+
+TEST(TestSPSCQueue, FifoOrder)
+{
+  panther_utils::SPSCQueue<int> queue(3);
+  EXPECT_EQ(queue.capacity(), 3u);
+  EXPECT_TRUE(queue.empty());
+
+  int value;
+  EXPECT_FALSE(queue.try_pop(value));
+  for (int i = 0; i < 3; i++) {
+    EXPECT_TRUE(queue.try_push(i));
+  }
+  EXPECT_FALSE(queue.try_push(3));
+  EXPECT_FALSE(queue.empty());
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.try_pop(value));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(TestSPSCQueue, WrapsAround)
+{
+  panther_utils::SPSCQueue<int> queue(2);
+  int value;
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(queue.try_push(i));
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(TestSPSCQueue, ConcurrentProducerConsumer)
+{
+  constexpr std::uint64_t items_count = 1000000;
+
+  panther_utils::SPSCQueue<std::uint64_t> queue(64);
+  std::thread producer([&queue]() {
+    for (std::uint64_t i = 1; i <= items_count; i++) {
+      while (!queue.try_push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  // items arrive in the order they were pushed
+  std::uint64_t expected = 1;
+  std::uint64_t value;
+  while (expected <= items_count) {
+    if (queue.try_pop(value)) {
+      ASSERT_EQ(value, expected);
+      expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  EXPECT_TRUE(queue.empty());
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}